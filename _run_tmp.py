@@ -0,0 +1,680 @@
+#!/usr/bin/python3
+from genericpath import exists
+import subprocess
+import os
+import time
+from xmlrpc.client import boolean
+#import numpy as np
+import copy
+import shutil
+import random
+from datetime import datetime
+import sys
+import os
+import argparse
+from datetime import date
+
+# randomID
+random.seed(int(datetime.now().timestamp()))
+MAX_RAND_RANGE = 1000000000
+
+# config template
+config_template = """TOPOLOGY_FILE config/{topo}.txt
+FLOW_FILE config/{flow}.txt
+
+FLOW_INPUT_FILE mix/output/{id}/{name}_in.txt
+CNP_OUTPUT_FILE mix/output/{id}/{name}_out_cnp.txt
+FCT_OUTPUT_FILE mix/output/{id}/{name}_out_fct.txt
+PFC_OUTPUT_FILE mix/output/{id}/{name}_out_pfc.txt
+QLEN_MON_FILE mix/output/{id}/{name}_out_qlen.txt
+VOQ_MON_FILE mix/output/{id}/{name}_out_voq.txt
+VOQ_MON_DETAIL_FILE mix/output/{id}/{name}_out_voq_per_dst.txt
+UPLINK_MON_FILE mix/output/{id}/{name}_out_uplink.txt
+CONN_MON_FILE mix/output/{id}/{name}_out_conn.txt
+EST_ERROR_MON_FILE mix/output/{id}/{name}_out_est_error.txt
+
+QLEN_MON_START {qlen_mon_start}
+QLEN_MON_END {qlen_mon_end}
+SW_MONITORING_INTERVAL {sw_monitoring_interval}
+
+FLOWGEN_START_TIME {flowgen_start_time}
+FLOWGEN_STOP_TIME {flowgen_stop_time}
+BUFFER_SIZE {buffer_size}
+
+CC_MODE {cc_mode}
+LB_MODE {lb_mode}
+ENABLE_PFC {enabled_pfc}
+ENABLE_IRN {enabled_irn}
+
+CONWEAVE_TX_EXPIRY_TIME {cwh_tx_expiry_time}
+CONWEAVE_REPLY_TIMEOUT_EXTRA {cwh_extra_reply_deadline}
+CONWEAVE_PATH_PAUSE_TIME {cwh_path_pause_time}
+CONWEAVE_EXTRA_VOQ_FLUSH_TIME {cwh_extra_voq_flush_time}
+CONWEAVE_DEFAULT_VOQ_WAITING_TIME {cwh_default_voq_waiting_time}
+
+ALPHA_RESUME_INTERVAL 1
+RATE_DECREASE_INTERVAL 4
+CLAMP_TARGET_RATE 0
+RP_TIMER 300 
+FAST_RECOVERY_TIMES 1
+EWMA_GAIN {ewma_gain}
+RATE_AI {ai}Mb/s
+RATE_HAI {hai}Mb/s
+MIN_RATE 100Mb/s
+DCTCP_RATE_AI {dctcp_ai}Mb/s
+
+ERROR_RATE_PER_LINK 0.0000
+L2_CHUNK_SIZE 4000
+L2_ACK_INTERVAL 1
+L2_BACK_TO_ZERO 0
+
+RATE_BOUND 1
+HAS_WIN {has_win}
+VAR_WIN {var_win}
+FAST_REACT {fast_react}
+MI_THRESH {mi}
+INT_MULTI {int_multi}
+GLOBAL_T 1
+U_TARGET 0.95
+MULTI_RATE 0
+SAMPLE_FEEDBACK 0
+
+ENABLE_QCN 1
+USE_DYNAMIC_PFC_THRESHOLD 1
+PACKET_PAYLOAD_SIZE 1000
+
+
+LINK_DOWN 0 0 0
+KMAX_MAP {kmax_map}
+KMIN_MAP {kmin_map}
+PMAX_MAP {pmax_map}
+LOAD {load}
+RANDOM_SEED 1
+
+# CPEM (Credit-based PFC Enhancement Module) Configuration
+CPEM_ENABLED {cpem_enabled}
+CPEM_FEEDBACK_INTERVAL {cpem_feedback_interval}
+CPEM_CREDIT_DECAY_ALPHA {cpem_credit_decay_alpha}
+CPEM_INFLIGHT_DISCOUNT {cpem_inflight_discount}
+CPEM_CREDIT_TO_RATE_GAIN {cpem_credit_to_rate_gain}
+CPEM_MIN_RATE_RATIO {cpem_min_rate_ratio}
+CPEM_MAX_CREDIT {cpem_max_credit}
+
+# CPEM Threshold Configuration
+# If CPEM_USE_DYNAMIC_THRESHOLD=1, thresholds follow PFC dynamic threshold
+# If CPEM_USE_DYNAMIC_THRESHOLD=0, use fixed thresholds below
+CPEM_USE_DYNAMIC_THRESHOLD {cpem_use_dynamic_threshold}
+CPEM_THRESHOLD_LOW_RATIO {cpem_threshold_low_ratio}
+CPEM_THRESHOLD_HIGH_RATIO {cpem_threshold_high_ratio}
+
+# Static thresholds (used when CPEM_USE_DYNAMIC_THRESHOLD=0)
+CPEM_QUEUE_THRESHOLD_LOW {cpem_queue_threshold_low}
+CPEM_QUEUE_THRESHOLD_HIGH {cpem_queue_threshold_high}
+
+# MEDU Flow Classification
+MEDU_ENABLED {medu_enabled}
+FLOW_SIZE_THRESHOLD {flow_size_threshold}
+
+# Differentiated CC Parameters (requires MEDU enabled)
+ENABLE_DIFF_CC {enable_diff_cc}
+SHORT_FLOW_RATE_AI {short_flow_rate_ai}Mb/s
+SHORT_FLOW_RATE_HAI {short_flow_rate_hai}Mb/s
+SHORT_FLOW_EWMA_GAIN {short_flow_ewma_gain}
+SHORT_FLOW_ALPHA_RESUME_INTERVAL {short_flow_alpha_resume_interval}
+SHORT_FLOW_RATE_DECREASE_INTERVAL {short_flow_rate_decrease_interval}
+SHORT_FLOW_RP_TIMER {short_flow_rp_timer}
+SHORT_FLOW_FAST_RECOVERY_TIMES {short_flow_fast_recovery_times}
+LONG_FLOW_RATE_AI {long_flow_rate_ai}Mb/s
+LONG_FLOW_RATE_HAI {long_flow_rate_hai}Mb/s
+LONG_FLOW_EWMA_GAIN {long_flow_ewma_gain}
+LONG_FLOW_ALPHA_RESUME_INTERVAL {long_flow_alpha_resume_interval}
+LONG_FLOW_RATE_DECREASE_INTERVAL {long_flow_rate_decrease_interval}
+LONG_FLOW_RP_TIMER {long_flow_rp_timer}
+LONG_FLOW_FAST_RECOVERY_TIMES {long_flow_fast_recovery_times}
+"""
+
+
+# LB/CC mode matching
+cc_modes = {
+    "none": 0,
+    "dcqcn": 1,
+    "hpcc": 3,
+    "timely": 7,
+    "dctcp": 8,
+}
+
+lb_modes = {
+    "fecmp": 0,
+    "drill": 2,
+    "conga": 3,
+    "letflow": 6,
+    "conweave": 9,
+}
+
+topo2bdp = {
+    "leaf_spine_128_100G_OS2": 104000,  # 2-tier -> all 100Gbps
+    "leaf_spine_32_100G_OS2": 104000,  # 2-tier -> all 100Gbps
+    "leaf_spine_8_100G_OS2": 104000,  # 2-tier -> all 100Gbps
+    "fat_k8_100G_OS2": 156000,  # 3-tier -> all 100Gbps
+}
+
+FLOWGEN_DEFAULT_TIME = 2.0  # see /traffic_gen/traffic_gen.py::base_t
+
+
+def main():
+    # make directory if not exists
+    isExist = os.path.exists(os.getcwd() + "/mix/output/")
+    if not isExist:
+        os.makedirs(os.getcwd() + "/mix/output/")
+        print("The new directory is created - {}".format(os.getcwd() + "/mix/output/"))
+
+    parser = argparse.ArgumentParser(description='run simulation')
+    parser.add_argument('--cc', dest='cc', action='store',
+                        default='dcqcn', help="none/hpcc/dcqcn/timely/dctcp (default: dcqcn)")
+    parser.add_argument('--lb', dest='lb', action='store',
+                        default='fecmp', help="fecmp/pecmp/drill/conga (default: fecmp)")
+    parser.add_argument('--pfc', dest='pfc', action='store',
+                        type=int, default=1, help="enable PFC (default: 1)")
+    parser.add_argument('--irn', dest='irn', action='store',
+                        type=int, default=0, help="enable IRN (default: 0)")
+    parser.add_argument('--simul_time', dest='simul_time', action='store',
+                        default='0.1', help="traffic time to simulate (up to 3 seconds) (default: 0.1)")
+    parser.add_argument('--buffer', dest="buffer", action='store',
+                        default='9', help="the switch buffer size (MB) (default: 9)")
+    parser.add_argument('--netload', dest='netload', action='store', type=int,
+                        default=40, help="Network load at NIC to generate traffic (default: 40.0)")
+    parser.add_argument('--bw', dest="bw", action='store',
+                        default='100', help="the NIC bandwidth (Gbps) (default: 100)")
+    parser.add_argument('--topo', dest='topo', action='store',
+                        default='leaf_spine_128_100G', help="the name of the topology file (default: leaf_spine_128_100G_OS2)")
+    parser.add_argument('--cdf', dest='cdf', action='store',
+                        default='AliStorage2019', help="the name of the cdf file (default: AliStorage2019)")
+    parser.add_argument('--enforce_win', dest='enforce_win', action='store',
+                        type=int, default=0, help="enforce to use window scheme (default: 0)")
+    parser.add_argument('--sw_monitoring_interval', dest='sw_monitoring_interval', action='store',
+                        type=int, default=10000, help="interval of sampling statistics for queue status (default: 10000ns)")
+    parser.add_argument('--cpem', dest='cpem', action='store',
+                        type=int, default=0, help="enable CPEM module (default: 0)")
+    parser.add_argument('--cpem-feedback-interval', dest='cpem_feedback_interval', action='store',
+                        type=int, default=2000, help="CPEM feedback interval (default: 2000)")
+    parser.add_argument('--cpem-credit-decay-alpha', dest='cpem_credit_decay_alpha', action='store',
+                        type=float, default=0.8, help="CPEM credit decay alpha (default: 0.8)")
+    parser.add_argument('--cpem-inflight-discount', dest='cpem_inflight_discount', action='store',
+                        type=float, default=0.4, help="CPEM inflight discount factor (default: 0.4)")
+    parser.add_argument('--cpem-credit-to-rate-gain', dest='cpem_credit_to_rate_gain', action='store',
+                        type=float, default=1.0, help="CPEM credit-to-rate gain (default: 1.0)")
+    parser.add_argument('--cpem-min-rate-ratio', dest='cpem_min_rate_ratio', action='store',
+                        type=float, default=0.05, help="CPEM minimum rate ratio (default: 0.05)")
+    parser.add_argument('--cpem-max-credit', dest='cpem_max_credit', action='store',
+                        type=float, default=1000.0, help="CPEM maximum credit (default: 1000)")
+    parser.add_argument('--cpem-use-dynamic-threshold', dest='cpem_use_dynamic_threshold', action='store',
+                        type=int, default=1, help="CPEM threshold mode: 1=dynamic, 0=static (default: 1)")
+    parser.add_argument('--cpem-threshold-low-ratio', dest='cpem_threshold_low_ratio', action='store',
+                        type=float, default=0.5, help="CPEM dynamic low threshold ratio (default: 0.5)")
+    parser.add_argument('--cpem-threshold-high-ratio', dest='cpem_threshold_high_ratio', action='store',
+                        type=float, default=0.8, help="CPEM dynamic high threshold ratio (default: 0.8)")
+    parser.add_argument('--cpem-queue-threshold-low', dest='cpem_queue_threshold_low', action='store',
+                        type=int, default=10000, help="CPEM low queue threshold in bytes (default: 10000)")
+    parser.add_argument('--cpem-queue-threshold-high', dest='cpem_queue_threshold_high', action='store',
+                        type=int, default=100000, help="CPEM high queue threshold in bytes (default: 100000)")
+    parser.add_argument('--medu', dest='medu', action='store',
+                        type=int, default=0, help="enable MEDU flow classification (default: 0)")
+    parser.add_argument('--flow-threshold-kb', dest='flow_threshold_kb', action='store',
+                        type=int, default=100, help="flow size threshold for MEDU classification in KB (default: 100)")
+    parser.add_argument('--diff-cc', dest='diff_cc', action='store',
+                        type=int, default=0, help="enable differentiated CC params for long/short flows (default: 0)")
+    parser.add_argument('--short-ai-factor', dest='short_ai_factor', action='store',
+                        type=float, default=2.0, help="short flow RATE_AI multiplier relative to global (default: 2.0)")
+    parser.add_argument('--short-hai-factor', dest='short_hai_factor', action='store',
+                        type=float, default=2.0, help="short flow RATE_HAI multiplier relative to global (default: 2.0)")
+    parser.add_argument('--long-ai-factor', dest='long_ai_factor', action='store',
+                        type=float, default=1.0, help="long flow RATE_AI multiplier relative to global (default: 1.0)")
+    parser.add_argument('--long-hai-factor', dest='long_hai_factor', action='store',
+                        type=float, default=1.0, help="long flow RATE_HAI multiplier relative to global (default: 1.0)")
+    parser.add_argument('--short-ewma-gain', dest='short_ewma_gain', action='store',
+                        type=float, default=-1, help="short flow EWMA_GAIN (default: -1, use global)")
+    parser.add_argument('--short-alpha-resume', dest='short_alpha_resume', action='store',
+                        type=float, default=1, help="short flow ALPHA_RESUME_INTERVAL (default: 1)")
+    parser.add_argument('--short-rate-decrease', dest='short_rate_decrease', action='store',
+                        type=float, default=4, help="short flow RATE_DECREASE_INTERVAL (default: 4)")
+    parser.add_argument('--short-rp-timer', dest='short_rp_timer', action='store',
+                        type=float, default=300, help="short flow RP_TIMER (default: 300)")
+    parser.add_argument('--short-fast-recovery', dest='short_fast_recovery', action='store',
+                        type=int, default=1, help="short flow FAST_RECOVERY_TIMES (default: 1)")
+    parser.add_argument('--long-ewma-gain', dest='long_ewma_gain', action='store',
+                        type=float, default=-1, help="long flow EWMA_GAIN (default: -1, use global)")
+    parser.add_argument('--long-alpha-resume', dest='long_alpha_resume', action='store',
+                        type=float, default=1, help="long flow ALPHA_RESUME_INTERVAL (default: 1)")
+    parser.add_argument('--long-rate-decrease', dest='long_rate_decrease', action='store',
+                        type=float, default=4, help="long flow RATE_DECREASE_INTERVAL (default: 4)")
+    parser.add_argument('--long-rp-timer', dest='long_rp_timer', action='store',
+                        type=float, default=300, help="long flow RP_TIMER (default: 300)")
+    parser.add_argument('--long-fast-recovery', dest='long_fast_recovery', action='store',
+                        type=int, default=1, help="long flow FAST_RECOVERY_TIMES (default: 1)")
+    parser.add_argument('--id', dest='id', action='store',
+                        default=None, help="custom output ID (default: random)")
+
+    # #### CONWEAVE PARAMETERS ####
+    # parser.add_argument('--cwh_extra_reply_deadline', dest='cwh_extra_reply_deadline', action='store',
+    #                     type=int, default=4, help="extra-timeout, where reply_deadline = base-RTT + extra-timeout (default: 4us)")
+    # parser.add_argument('--cwh_path_pause_time', dest='cwh_path_pause_time', action='store',
+    #                     type=int, default=16, help="Time to pause the path with ECN feedback (default: 8us")
+    # parser.add_argument('--cwh_extra_voq_flush_time', dest='cwh_extra_voq_flush_time', action='store',
+    #                     type=int, default=16, help="Extra VOQ Flush Time (default: 8us for IRN)")
+    # parser.add_argument('--cwh_default_voq_waiting_time', dest='cwh_default_voq_waiting_time', action='store',
+    #                     type=int, default=400, help="Default VOQ Waiting Time (default: 400us)")
+    # parser.add_argument('--cwh_tx_expiry_time', dest='cwh_tx_expiry_time', action='store',
+    #                     type=int, default=1000, help="timeout value of ConWeave Tx for CLEAR signal (default: 1000us)")
+
+    args = parser.parse_args()
+    args.cc = args.cc.lower()
+    args.lb = args.lb.lower()
+
+    # make running ID of this config
+    if args.id:
+        config_ID = args.id
+        config_name_prefix = os.path.basename(args.id)
+    else:
+        # need to check directory exists or not
+        isExist = True
+        config_ID = 0
+        while (isExist):
+            config_ID = str(random.randrange(MAX_RAND_RANGE))
+            isExist = os.path.exists(os.getcwd() + "/mix/output/" + config_ID)
+        config_name_prefix = config_ID
+
+    # input parameters
+    if args.cc not in cc_modes:
+        raise Exception("CONFIG ERROR : unsupported cc '{}'. Supported: {}".format(
+            args.cc, "/".join(sorted(cc_modes.keys()))))
+    if args.lb not in lb_modes:
+        raise Exception("CONFIG ERROR : unsupported lb '{}'. Supported: {}".format(
+            args.lb, "/".join(sorted(lb_modes.keys()))))
+
+    cc_mode = cc_modes[args.cc]
+    lb_mode = lb_modes[args.lb]
+    enabled_pfc = int(args.pfc)
+    enabled_irn = int(args.irn)
+    cpem_enabled = int(args.cpem)
+    cpem_feedback_interval = int(args.cpem_feedback_interval)
+    cpem_credit_decay_alpha = float(args.cpem_credit_decay_alpha)
+    cpem_inflight_discount = float(args.cpem_inflight_discount)
+    cpem_credit_to_rate_gain = float(args.cpem_credit_to_rate_gain)
+    cpem_min_rate_ratio = float(args.cpem_min_rate_ratio)
+    cpem_max_credit = float(args.cpem_max_credit)
+    cpem_use_dynamic_threshold = int(args.cpem_use_dynamic_threshold)
+    cpem_threshold_low_ratio = float(args.cpem_threshold_low_ratio)
+    cpem_threshold_high_ratio = float(args.cpem_threshold_high_ratio)
+    cpem_queue_threshold_low = int(args.cpem_queue_threshold_low)
+    cpem_queue_threshold_high = int(args.cpem_queue_threshold_high)
+    enable_flow_classification = int(args.medu)
+    flow_size_threshold = int(args.flow_threshold_kb) * 1000
+    enable_diff_cc = int(args.diff_cc)
+    bw = int(args.bw)
+    buffer = args.buffer
+    topo = args.topo
+    enforce_win = args.enforce_win
+    cdf = args.cdf
+    flowgen_start_time = FLOWGEN_DEFAULT_TIME  # default: 2.0
+    flowgen_stop_time = flowgen_start_time + \
+        float(args.simul_time)  # default: 2.0
+    sw_monitoring_interval = int(args.sw_monitoring_interval)
+
+    if flow_size_threshold <= 0:
+        raise Exception("CONFIG ERROR : flow-threshold-kb must be positive.")
+
+    if enable_diff_cc and not enable_flow_classification:
+        print("INFO: ENABLE_DIFF_CC requires MEDU; forcing ENABLE_DIFF_CC to 0 because --medu=0.")
+        enable_diff_cc = 0
+
+    if cpem_use_dynamic_threshold not in [0, 1]:
+        raise Exception("CONFIG ERROR : cpem-use-dynamic-threshold must be 0 or 1.")
+    if cpem_threshold_low_ratio < 0 or cpem_threshold_high_ratio < 0 or cpem_threshold_low_ratio > cpem_threshold_high_ratio:
+        raise Exception("CONFIG ERROR : cpem-threshold-low-ratio/high-ratio invalid (require 0<=low<=high).")
+    if cpem_queue_threshold_low < 0 or cpem_queue_threshold_high < cpem_queue_threshold_low:
+        raise Exception("CONFIG ERROR : static CPEM queue thresholds invalid (require 0<=low<=high).")
+
+    # get over-subscription ratio from topoogy name
+
+    netload = args.netload
+    oversub = int(topo.replace("\n", "").split("OS")[-1].replace(".txt", ""))
+    assert (int(args.netload) % oversub == 0)
+    hostload = int(args.netload) / oversub
+    assert (hostload > 0)
+
+    # Sanity checks
+    if (args.cc == "timely" or args.cc == "hpcc") and args.lb == "conweave":
+        raise Exception(
+            "CONFIG ERROR : ConWeave currently does not support RTT-based protocols. Plz modify its logic accordingly.")
+    if enabled_irn == 1 and enabled_pfc == 1:
+        raise Exception(
+            "CONFIG ERROR : If IRN is turn-on, then you should turn off PFC (for better perforamnce).")
+    if enabled_irn == 0 and enabled_pfc == 0:
+        raise Exception(
+            "CONFIG ERROR : Either IRN or PFC should be true (at least one).")
+    if float(args.simul_time) < 0.005:
+        raise Exception("CONFIG ERROR : Runtime must be larger than 5ms (= warmup interval).")
+
+    # sniff number of servers
+    with open("config/{topo}.txt".format(topo=args.topo), 'r') as f_topo:
+        line = f_topo.readline().split(" ")
+        n_host = int(line[0]) - int(line[1])
+
+    assert (hostload >= 0 and hostload < 100)
+    flow = "L_{load:.2f}_CDF_{cdf}_N_{n_host}_T_{time}ms_B_{bw}_flow".format(
+        load=hostload, cdf=args.cdf, n_host=n_host, time=int(float(args.simul_time)*1000), bw=bw)
+
+    # check the file exists
+    if (exists(os.getcwd() + "/config/" + flow + ".txt")):
+        print("Input traffic file with load:{load:.2f}, cdf:{cdf}, n_host:{n_host} already exists".format(
+            load=hostload, cdf=cdf, n_host=n_host))
+    else:  # make the input traffic file
+        print("Generate a input traffic file...")
+        print("python ./traffic_gen/traffic_gen.py -c {cdf} -n {n_host} -l {load} -b {bw} -t {time} -o {output}".format(
+            cdf=os.getcwd() + "/traffic_gen/" + args.cdf + ".txt",
+            n_host=n_host,
+            load=hostload / 100.0,
+            bw=args.bw + "G",
+            time=args.simul_time,
+            output=os.getcwd() + "/config/" + flow + ".txt"))
+
+        os.system("python ./traffic_gen/traffic_gen.py -c {cdf} -n {n_host} -l {load} -b {bw} -t {time} -o {output}".format(
+            cdf=os.getcwd() + "/traffic_gen/" + args.cdf + ".txt",
+            n_host=n_host,
+            load=hostload / 100.0,
+            bw=args.bw + "G",
+            time=args.simul_time,
+            output=os.getcwd() + "/config/" + flow + ".txt"))
+
+    # sanity check - bandwidth
+    with open("config/{topo}.txt".format(topo=args.topo), 'r') as f_topo:
+        first_line = f_topo.readline().split(" ")
+        n_host = int(first_line[0]) - int(first_line[1])
+        n_link = int(first_line[2])
+        i = 0
+        for line in f_topo.readlines()[1:]:
+            i += 1
+            if (i > n_link):
+                break
+            parsed = line.split(" ")
+            if len(parsed) > 2 and (int(parsed[0]) < n_host or int(parsed[1]) < n_host):
+                assert (int(parsed[2].replace("Gbps", "")) == int(bw))
+    print("All NIC bandwidth is {bw}Gbps".format(bw=bw))
+
+    ##################################################################
+    ##########              ConWeave parameters             ##########
+    ##################################################################
+    if (lb_mode == 9):
+        cwh_extra_reply_deadline = 4  # 4us, NOTE: this is "extra" term to base RTT
+        cwh_path_pause_time = 16  # 8us (K_min) or 16us
+
+        if "leaf_spine" in topo:  # 2-tier
+            cwh_extra_voq_flush_time = 16
+            cwh_default_voq_waiting_time = 200
+            cwh_tx_expiry_time = 300  # 300us
+        elif "fat" in topo and enabled_pfc == 0 and enabled_irn == 1:  # 3-tier, IRN
+            cwh_extra_voq_flush_time = 16
+            cwh_default_voq_waiting_time = 300
+            cwh_tx_expiry_time = 1000  # 1ms
+        elif "fat" in topo and enabled_pfc == 1 and enabled_irn == 0:  # 3-tier, Lossless
+            cwh_extra_voq_flush_time = 64
+            cwh_default_voq_waiting_time = 600
+            cwh_tx_expiry_time = 1000  # 1ms
+        else:
+            raise Exception(
+                "Unsupported ConWeave Parameter Setup")
+    else:
+        #### CONWEAVE PARAMETERS (DUMMY) ####
+        cwh_extra_reply_deadline = 4
+        cwh_path_pause_time = 16
+        cwh_extra_voq_flush_time = 64
+        cwh_default_voq_waiting_time = 400
+        cwh_tx_expiry_time = 1000
+
+    ##################################################################
+
+    # make directory if not exists
+    output_dir = os.path.join(os.getcwd(), "mix/output", config_ID)
+    if not os.path.exists(output_dir):
+        os.makedirs(output_dir)
+    
+    print("The new directory is created  - {}".format(output_dir))
+
+    config_name = os.path.join(output_dir, "config.txt")
+    print("Config filename:{}".format(config_name))
+
+    # By default, DCQCN uses no window (rate-based).
+    has_win = 0
+    var_win = 0
+    if (cc_mode == 3 or cc_mode == 8 or enforce_win == 1):  # HPCC or DCTCP or enforcement
+        has_win = 1
+        var_win = 1
+        if enforce_win == 1:
+            print("### INFO: Enforced to use window scheme! ###")
+
+    # record to history
+    simulday = datetime.now().strftime("%m/%d/%y")
+    with open("./mix/.history", "a") as history:
+        history.write("{simulday},{config_ID},{cc_mode},{lb_mode},{cwh_tx_expiry_time},{cwh_extra_reply_deadline},{cwh_path_pause_time},{cwh_extra_voq_flush_time},{cwh_default_voq_waiting_time},{pfc},{irn},{has_win},{var_win},{topo},{bw},{cdf},{load},{time}\n".format(
+            simulday=simulday,
+            config_ID=config_ID,
+            cc_mode=cc_mode,
+            lb_mode=lb_mode,
+            cwh_tx_expiry_time=cwh_tx_expiry_time,
+            cwh_extra_reply_deadline=cwh_extra_reply_deadline,
+            cwh_path_pause_time=cwh_path_pause_time,
+            cwh_extra_voq_flush_time=cwh_extra_voq_flush_time,
+            cwh_default_voq_waiting_time=cwh_default_voq_waiting_time,
+            pfc=enabled_pfc,
+            irn=enabled_irn,
+            has_win=has_win,
+            var_win=var_win,
+            topo=topo,
+            bw=bw,
+            cdf=cdf,
+            load=netload,
+            time=args.simul_time,
+        ))
+
+    # 1 BDP calculation
+    if topo2bdp.get(topo) == None:
+        print("ERROR - topology is not registered in run.py!!", flush=True)
+        return
+    bdp = int(topo2bdp[topo])
+    print("1BDP = {}".format(bdp))
+
+    # DCQCN parameters (NOTE: HPCC's 400KB/1600KB is too large, although used in Microsoft)
+    kmax_map = "6 %d %d %d %d %d %d %d %d %d %d %d %d" % (
+        bw*200000000, 400, bw*500000000, 400, bw*1000000000, 400, bw*2*1000000000, 400, bw*2500000000, 400, bw*4*1000000000, 400)
+    kmin_map = "6 %d %d %d %d %d %d %d %d %d %d %d %d" % (
+        bw*200000000, 100, bw*500000000, 100, bw*1000000000, 100, bw*2*1000000000, 100, bw*2500000000, 100, bw*4*1000000000, 100)
+    pmax_map = "6 %d %d %d %d %d %.2f %d %.2f %d %.2f %d %.2f" % (
+        bw*200000000, 0.2, bw*500000000, 0.2, bw*1000000000, 0.2, bw*2*1000000000, 0.2, bw*2500000000, 0.2, bw*4*1000000000, 0.2)
+
+    # queue monitoring
+    qlen_mon_start = flowgen_start_time
+    qlen_mon_end = flowgen_stop_time
+
+    if cc_mode in (0, 1):  # no-CC or DCQCN
+        ai = 10 * bw / 25
+        hai = 25 * bw / 25
+        dctcp_ai = 1000
+        fast_react = 0
+        mi = 0
+        int_multi = 1
+        ewma_gain = 0.00390625
+    elif cc_mode == 3:  # HPCC
+        ai = 5 * bw / 25
+        hai = 50 * bw / 25
+        dctcp_ai = 1000
+        fast_react = 1
+        mi = 5
+        int_multi = 1
+        ewma_gain = 0.00390625
+    elif cc_mode == 7:  # TIMELY
+        ai = 5 * bw / 25
+        hai = 50 * bw / 25
+        dctcp_ai = 1000
+        fast_react = 0
+        mi = 5
+        int_multi = 1
+        ewma_gain = 0.00390625
+    elif cc_mode == 8:  # DCTCP
+        ai = 10 * bw / 25
+        hai = 25 * bw / 25
+        dctcp_ai = 1000 * bw / 100
+        fast_react = 0
+        mi = 0
+        int_multi = 1
+        ewma_gain = 0.0625
+    else:
+        raise Exception("CONFIG ERROR : unsupported cc '{}' (mode={})".format(args.cc, cc_mode))
+
+    # Differentiated CC params: compute per-flow-type AI/HAI from factors
+    short_flow_ai = ai * args.short_ai_factor
+    short_flow_hai = hai * args.short_hai_factor
+    long_flow_ai = ai * args.long_ai_factor
+    long_flow_hai = hai * args.long_hai_factor
+
+    # Per-flow-type CC params (use global value if not explicitly set)
+    short_ewma = args.short_ewma_gain if args.short_ewma_gain >= 0 else ewma_gain
+    long_ewma = args.long_ewma_gain if args.long_ewma_gain >= 0 else ewma_gain
+
+    config = config_template.format(id=config_ID, name=config_name_prefix, topo=topo, flow=flow,
+                                    qlen_mon_start=qlen_mon_start, qlen_mon_end=qlen_mon_end, flowgen_start_time=flowgen_start_time,
+                                    flowgen_stop_time=flowgen_stop_time, sw_monitoring_interval=sw_monitoring_interval,
+                                    load=netload, buffer_size=buffer, lb_mode=lb_mode, cwh_tx_expiry_time=cwh_tx_expiry_time,
+                                    cwh_extra_reply_deadline=cwh_extra_reply_deadline, cwh_default_voq_waiting_time=cwh_default_voq_waiting_time,
+                                    cwh_path_pause_time=cwh_path_pause_time, cwh_extra_voq_flush_time=cwh_extra_voq_flush_time,
+                                    enabled_pfc=enabled_pfc, enabled_irn=enabled_irn,
+                                    cc_mode=cc_mode,
+                                    ai=ai, hai=hai, dctcp_ai=dctcp_ai,
+                                    has_win=has_win, var_win=var_win,
+                                    fast_react=fast_react, mi=mi, int_multi=int_multi, ewma_gain=ewma_gain,
+                                    kmax_map=kmax_map, kmin_map=kmin_map, pmax_map=pmax_map,
+                                    cpem_enabled=cpem_enabled,
+                                    cpem_feedback_interval=cpem_feedback_interval,
+                                    cpem_credit_decay_alpha=cpem_credit_decay_alpha,
+                                    cpem_inflight_discount=cpem_inflight_discount,
+                                    cpem_credit_to_rate_gain=cpem_credit_to_rate_gain,
+                                    cpem_min_rate_ratio=cpem_min_rate_ratio,
+                                    cpem_max_credit=cpem_max_credit,
+                                    cpem_use_dynamic_threshold=cpem_use_dynamic_threshold,
+                                    cpem_threshold_low_ratio=cpem_threshold_low_ratio,
+                                    cpem_threshold_high_ratio=cpem_threshold_high_ratio,
+                                    cpem_queue_threshold_low=cpem_queue_threshold_low,
+                                    cpem_queue_threshold_high=cpem_queue_threshold_high,
+                                    medu_enabled=enable_flow_classification,
+                                    enable_flow_classification=enable_flow_classification,
+                                    flow_size_threshold=flow_size_threshold,
+                                    enable_diff_cc=enable_diff_cc,
+                                    short_flow_rate_ai=short_flow_ai,
+                                    short_flow_rate_hai=short_flow_hai,
+                                    short_flow_ewma_gain=short_ewma,
+                                    short_flow_alpha_resume_interval=args.short_alpha_resume,
+                                    short_flow_rate_decrease_interval=args.short_rate_decrease,
+                                    short_flow_rp_timer=args.short_rp_timer,
+                                    short_flow_fast_recovery_times=args.short_fast_recovery,
+                                    long_flow_rate_ai=long_flow_ai,
+                                    long_flow_rate_hai=long_flow_hai,
+                                    long_flow_ewma_gain=long_ewma,
+                                    long_flow_alpha_resume_interval=args.long_alpha_resume,
+                                    long_flow_rate_decrease_interval=args.long_rate_decrease,
+                                    long_flow_rp_timer=args.long_rp_timer,
+                                    long_flow_fast_recovery_times=args.long_fast_recovery)
+
+    with open(config_name, "w") as file:
+        file.write(config)
+
+    # run program
+    print("Running simulation...")
+    output_log = config_name.replace(".txt", ".log")
+    # 说明：下面的命令会用生成的 config 文件运行 ns-3 程序 `scratch/network-load-balance`。
+    # 调用链为：
+    #   run.py::main()
+    #   -> ./waf --run 'scratch/network-load-balance {config}'
+    #   -> C++ 入口：scratch/network-load-balance.cc::main(int argc, char**)
+    #      - 读取配置，搭建拓扑，安装 RDMA 驱动/硬件
+    #      - 通过 ScheduleFlowInputs() 调度与生成流
+    #      - 每条流在开始时间触发：
+    #          源主机调用 RdmaClientHelper.Install(...)
+    #          -> RdmaClient::StartApplication()
+    #             -> RdmaDriver::AddQueuePair(...)
+    #                -> RdmaHw::AddQueuePair(...)
+    #          数据/ACK/NACK 路径：RdmaHw::ReceiveUdp()/ReceiveAck()
+    #          流完成：RdmaHw::QpComplete()
+    #             -> RdmaDriver::QpComplete（trace）
+    #             -> network-load-balance.cc::qp_finish(...) 写入 FCT 并删除接收端 RxQP
+    run_command = "./waf --run 'scratch/network-load-balance {config_name}' > {output_log} 2>&1".format(
+        config_name=config_name, output_log=output_log)
+    with open("./mix/.history", "a") as history:
+        history.write(run_command + "\n")
+        history.write(
+            "./waf --run 'scratch/network-load-balance' --command-template='gdb --args %s {config_name}'\n".format(
+                config_name=config_name)
+        )
+        history.write("\n")
+
+    print(run_command)
+    sim_cmd = ["./waf", "--run", "scratch/network-load-balance {}".format(config_name)]
+    with open(output_log, "w") as sim_log:
+        sim_result = subprocess.run(sim_cmd, stdout=sim_log, stderr=subprocess.STDOUT)
+    if sim_result.returncode != 0:
+        raise RuntimeError(
+            "Simulation failed (exit code {}). Check log: {}".format(sim_result.returncode, output_log)
+        )
+
+    ####################################################
+    #                 Analyze the output FCT           #
+    ####################################################
+    # NOTE: collect data except warm-up and cold-finish period
+    fct_analysis_time_limit_begin = int(
+        flowgen_start_time * 1e9) + int(0.005 * 1e9)  # warmup
+    fct_analysistime_limit_end = int(
+        flowgen_stop_time * 1e9) + int(0.05 * 1e9)  # extra term
+
+    print("Analyzing output FCT...")
+    fct_analysis_log = os.path.join(output_dir, "fct_analysis.log")
+    repo_dir = os.path.dirname(os.path.abspath(__file__))
+    project_venv_python = os.path.join(os.path.dirname(repo_dir), ".venv", "bin", "python")
+    analysis_python = project_venv_python if os.path.exists(project_venv_python) else sys.executable
+    fct_cmd = [
+        analysis_python,
+        "fctAnalysis.py",
+        "-id", config_ID,
+        "-dir", os.getcwd(),
+        "-bdp", str(bdp),
+        "-sT", str(fct_analysis_time_limit_begin),
+        "-fT", str(fct_analysistime_limit_end),
+    ]
+    print("{} > {} 2>&1".format(" ".join(fct_cmd), fct_analysis_log))
+    with open(fct_analysis_log, "w") as fct_log:
+        fct_log.write("PYTHON_EXECUTABLE={}\n".format(analysis_python))
+        fct_log.write("CMD={}\n".format(" ".join(fct_cmd)))
+        result = subprocess.run(fct_cmd, stdout=fct_log, stderr=subprocess.STDOUT)
+    if result.returncode != 0:
+        raise RuntimeError(
+            "fctAnalysis failed (exit code {}). Check log: {}".format(result.returncode, fct_analysis_log)
+        )
+
+    if lb_mode == 9: # ConWeave Logging
+        ################################################################
+        #             Analyze hardware resource of ConWeave            #
+        ################################################################
+        # NOTE: collect data except warm-up and cold-finish period
+        queue_analysis_time_limit_begin = int(
+            flowgen_start_time * 1e9) + int(0.005 * 1e9)  # warmup
+        queue_analysistime_limit_end = int(flowgen_stop_time * 1e9)
+        print("Analyzing output Queue...")
+        print("python3 queueAnalysis.py -id {config_ID} -dir {dir} -sT {queue_analysis_time_limit_begin} -fT {queue_analysistime_limit_end} > /dev/null 2>&1".format(
+            config_ID=config_ID, dir=os.getcwd(), queue_analysis_time_limit_begin=queue_analysis_time_limit_begin, queue_analysistime_limit_end=queue_analysistime_limit_end))
+        os.system("python3 queueAnalysis.py -id {config_ID} -dir {dir} -sT {queue_analysis_time_limit_begin} -fT {queue_analysistime_limit_end} > /dev/null 2>&1".format(
+            config_ID=config_ID, dir=os.getcwd(), queue_analysis_time_limit_begin=queue_analysis_time_limit_begin, queue_analysistime_limit_end=queue_analysistime_limit_end,
+            monitoringInterval=sw_monitoring_interval))  # TODO: parameterize
+
+    print("\n\n============== Done ============== ")
+
+
+if __name__ == "__main__":
+    main()
+
@@ -0,0 +1,298 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ASYNC_TRACE_SINK_H
+#define ASYNC_TRACE_SINK_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief What AsyncTraceSink::Push does when the ring is (nearly) full
+ */
+enum TraceBackpressure
+{
+  TRACE_BLOCK = 0,   //!< wait for the I/O thread: nothing is lost
+  TRACE_DROP = 1,    //!< drop the record when the ring is full, and count it
+  TRACE_SAMPLE = 2   //!< past half full keep one record in N, drop when full
+};
+
+/**
+ * \brief Trace file written by a background thread
+ *
+ * The simulation thread pushes fixed-size Record values into a
+ * single-producer single-consumer ring; a dedicated I/O thread pops
+ * them, calls Record::Format (const Record &, std::string &) to append
+ * their text, and writes the text in large chunks.  Pushing a record
+ * costs a copy and two atomic operations: no formatting, no system call
+ * (std::endl used to flush the file at every record).  Records come out
+ * in the order they were pushed.
+ *
+ * The I/O thread sleeps on a condition variable while the ring is empty.
+ * Push wakes it once per batch of records (and when the ring is full),
+ * not at every record; Close writes whatever is left.
+ *
+ * In a parallel (NS3_MTP) build several simulation threads may push:
+ * they serialize on a spin lock.
+ */
+template <typename Record>
+class AsyncTraceSink
+{
+public:
+  /**
+   * \param file output, owned by the sink
+   * \param capacity ring size in records, rounded up to a power of two
+   * \param backpressure behaviour of Push when the I/O thread lags behind
+   * \param sampleEvery TRACE_SAMPLE keeps one record in sampleEvery
+   */
+  AsyncTraceSink (FILE *file, uint32_t capacity, TraceBackpressure backpressure,
+                  uint32_t sampleEvery)
+    : m_file (file),
+      m_backpressure (backpressure),
+      m_sampleEvery (sampleEvery > 0 ? sampleEvery : 1),
+      m_sampleCount (0),
+      m_dropped (0),
+      m_sampledOut (0),
+      m_head (0),
+      m_tail (0),
+      m_stop (false),
+      m_sleeping (false)
+  {
+    uint32_t size = 2;
+    while (size < capacity)
+      {
+        size <<= 1;
+      }
+    m_ring.resize (size);
+    m_mask = size - 1;
+    m_wakeMask = std::min<uint32_t> (256, size / 2) - 1;
+#ifdef NS3_MTP
+    m_lock.clear ();
+#endif
+    m_thread = std::thread (&AsyncTraceSink::Run, this);
+  }
+
+  ~AsyncTraceSink ()
+  {
+    Close ();
+  }
+
+  /**
+   * \brief Write text ahead of the records, e.g. a header (simulation thread,
+   * before the first Push)
+   */
+  void
+  WriteHeader (const std::string &text)
+  {
+    if (m_file)
+      {
+        fwrite (text.data (), 1, text.size (), m_file);
+      }
+  }
+
+  /**
+   * \returns false if the record was dropped or sampled out
+   */
+  bool
+  Push (const Record &record)
+  {
+#ifdef NS3_MTP
+    while (m_lock.test_and_set (std::memory_order_acquire))
+      {
+      }
+#endif
+    bool pushed = DoPush (record);
+#ifdef NS3_MTP
+    m_lock.clear (std::memory_order_release);
+#endif
+    return pushed;
+  }
+
+  /**
+   * \brief Write the records left, stop the I/O thread and close the file
+   */
+  void
+  Close ()
+  {
+    if (!m_thread.joinable ())
+      {
+        return;
+      }
+    m_stop.store (true, std::memory_order_release);
+    Wake ();
+    m_thread.join ();
+    if (m_file)
+      {
+        fclose (m_file);
+        m_file = 0;
+      }
+  }
+
+  uint64_t GetDropped (void) const { return m_dropped; }
+  uint64_t GetSampledOut (void) const { return m_sampledOut; }
+
+private:
+  bool
+  DoPush (const Record &record)
+  {
+    uint64_t head = m_head.load (std::memory_order_relaxed);
+    uint64_t used = head - m_tail.load (std::memory_order_acquire);
+    if (m_backpressure == TRACE_SAMPLE && used * 2 >= m_ring.size ()
+        && ++m_sampleCount % m_sampleEvery != 0)
+      {
+        m_sampledOut++;
+        return false;
+      }
+    while (used == m_ring.size ())
+      {
+        if (m_backpressure != TRACE_BLOCK)
+          {
+            m_dropped++;
+            return false;
+          }
+        WakeIfSleeping ();
+        std::this_thread::yield ();
+        used = head - m_tail.load (std::memory_order_acquire);
+      }
+    m_ring[head & m_mask] = record;
+    m_head.store (head + 1, std::memory_order_release);
+    if (((head + 1) & m_wakeMask) == 0)
+      {
+        WakeIfSleeping ();
+      }
+    return true;
+  }
+
+  void
+  WakeIfSleeping (void)
+  {
+    // pairs with the fence of Sleep: either the consumer sees the new
+    // head, or we see it asleep
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (m_sleeping.load (std::memory_order_relaxed))
+      {
+        Wake ();
+      }
+  }
+
+  void
+  Wake (void)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_cv.notify_one ();
+  }
+
+  /**
+   * \brief Wait until records follow tail, or Close
+   */
+  void
+  Sleep (uint64_t tail)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_sleeping.store (true, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    while (!m_stop.load (std::memory_order_acquire) && m_head.load (std::memory_order_acquire) == tail)
+      {
+        m_cv.wait (lock);
+      }
+    m_sleeping.store (false, std::memory_order_relaxed);
+  }
+
+  void
+  Run (void)
+  {
+    const size_t chunk = 1 << 16;
+    std::string text;
+    text.reserve (2 * chunk);
+    while (true)
+      {
+        bool stop = m_stop.load (std::memory_order_acquire);
+        uint64_t tail = m_tail.load (std::memory_order_relaxed);
+        uint64_t head = m_head.load (std::memory_order_acquire);
+        for (; tail != head; tail++)
+          {
+            Record::Format (m_ring[tail & m_mask], text);
+            if ((tail & 255) == 255)
+              {
+                m_tail.store (tail + 1, std::memory_order_release);
+              }
+            if (text.size () >= chunk)
+              {
+                Write (text);
+              }
+          }
+        m_tail.store (tail, std::memory_order_release);
+        if (stop)
+          {
+            break;  // the ring was drained after the stop request
+          }
+        if (text.size () > 0)
+          {
+            Write (text);
+          }
+        Sleep (tail);
+      }
+    Write (text);
+  }
+
+  void
+  Write (std::string &text)
+  {
+    if (m_file)
+      {
+        fwrite (text.data (), 1, text.size (), m_file);
+      }
+    text.clear ();
+  }
+
+  FILE *m_file;
+  TraceBackpressure m_backpressure;
+  uint32_t m_sampleEvery;
+  uint64_t m_sampleCount;
+  uint64_t m_dropped;
+  uint64_t m_sampledOut;
+  std::vector<Record> m_ring;
+  uint64_t m_mask;
+  uint64_t m_wakeMask;  //!< Push wakes the I/O thread when the head is a multiple of m_wakeMask + 1
+  // producer and consumer positions, 64 bytes apart so that they never
+  // share a cache line (the sink is allocated with plain new: no alignas)
+  char m_pad0[64];
+  std::atomic<uint64_t> m_head;
+  char m_pad1[64 - sizeof (std::atomic<uint64_t>)];
+  std::atomic<uint64_t> m_tail;
+  char m_pad2[64 - sizeof (std::atomic<uint64_t>)];
+  std::atomic<bool> m_stop;
+  std::atomic<bool> m_sleeping;  //!< the I/O thread waits on m_cv
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+#ifdef NS3_MTP
+  std::atomic_flag m_lock;
+#endif
+  std::thread m_thread;
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_TRACE_SINK_H */
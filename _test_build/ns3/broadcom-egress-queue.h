@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+* Copyright (c) 2006 Georgia Tech Research Corporation, INRIA
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef BROADCOM_EGRESS_H
+#define BROADCOM_EGRESS_H
+
+#include <fstream>
+#include <queue>
+#include <unordered_map>
+#include "ns3/packet.h"
+#include "queue.h"
+#include "drop-tail-queue.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/event-id.h"
+#include "async-trace-sink.h"
+
+namespace ns3 {
+
+	class TraceContainer;
+
+	/**
+	 * One line of the priority queue log: a packet enqueued at a switch
+	 * port (ENQ) or dequeued from a queue (DEQ, the port fields unused).
+	 */
+	struct PqLogRecord {
+		double time;  // seconds
+		bool dequeue;
+		uint32_t switchId;
+		uint32_t outDev;
+		uint32_t qIndex;
+		uint32_t src;
+		uint32_t sport;
+		uint32_t dst;
+		uint32_t dport;
+		uint32_t proto;
+		int32_t flowId;
+		uint64_t flowSize;
+		uint32_t pktSize;
+
+		static void Format(const PqLogRecord &r, std::string &out);
+	};
+
+	class BEgressQueue : public Queue {
+	public:
+		static TypeId GetTypeId(void);
+		static const unsigned fCnt = 128; //max number of queues, 128 for NICs
+		static const unsigned qCnt = 8; //max number of queues, 8 for switches
+		BEgressQueue();
+		virtual ~BEgressQueue();
+		bool Enqueue(Ptr<Packet> p, uint32_t qIndex);
+		Ptr<Packet> DequeueRR(bool paused[], bool allowLongFlow = true);
+		uint32_t GetNBytes(uint32_t qIndex) const;
+		uint32_t GetNBytesTotal() const;
+		uint32_t GetLastQueue();
+
+		// Throughput monitoring
+		uint64_t GetTotalTxBytes() const { return m_totalTxBytes; }
+		uint64_t GetTotalRxBytes() const { return m_totalRxBytes; }
+		void AddRxBytes(uint64_t bytes) { m_totalRxBytes += bytes; }
+
+		// Flow Classification (Long/Short Flow Separation) - static config
+		// These are set by the simulation main() and used during dequeue
+		static bool s_enableFlowClassification;
+		static uint16_t s_shortFlowPg;
+		static uint16_t s_longFlowPg;
+
+		// Priority Queue Logging - static config
+		// These are set by the simulation main() and used during enqueue/dequeue
+		// The log is written by a background thread (AsyncTraceSink).
+		static bool s_enablePqLogging;
+		static AsyncTraceSink<PqLogRecord>* s_pqLog;
+
+		TracedCallback<Ptr<const Packet>, uint32_t> m_traceBeqEnqueue;
+		TracedCallback<Ptr<const Packet>, uint32_t> m_traceBeqDequeue;
+		
+		std::unordered_map<int32_t, Time> current_pause_time;
+
+	private:
+		bool DoEnqueue(Ptr<Packet> p, uint32_t qIndex);
+		Ptr<Packet> DoDequeueRR(bool paused[], bool allowLongFlow);
+		//for compatibility
+		virtual bool DoEnqueue(Ptr<Packet> p);
+		virtual Ptr<Packet> DoDequeue(void);
+		virtual Ptr<const Packet> DoPeek(void) const;
+		double m_maxBytes; //total bytes limit
+		uint32_t m_bytesInQueue[fCnt];
+		uint32_t m_bytesInQueueTotal;
+		uint32_t m_rrlast;
+		uint32_t m_qlast;
+		std::vector<Ptr<Queue> > m_queues; // uc queues
+		
+		// Throughput monitoring counters
+		uint64_t m_totalTxBytes;  // Total bytes transmitted (dequeued)
+		uint64_t m_totalRxBytes;  // Total bytes received (enqueued)
+	};
+
+} // namespace ns3
+
+#endif /* DROPTAIL_H */
@@ -0,0 +1,440 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2023 NUS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Chahwan Song <songch@comp.nus.edu.sg>
+ */
+
+#ifndef __CONWEAVE_ROUTING_H__
+#define __CONWEAVE_ROUTING_H__
+
+#include <deque>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/conweave-voq.h"
+#include "ns3/event-id.h"
+#include "ns3/flow-state-table.h"
+#include "ns3/net-device.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/settings.h"
+#include "ns3/simulator.h"
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+#define CW_DEFAULT_32BIT (UINT32_MAX)
+#define CW_DEFAULT_64BIT (Seconds(100).GetNanoSeconds())
+#define CW_MAX_TIME (Seconds(100))
+#define CW_MIN_TIME (Seconds(0))
+
+/************************************************************************************************
+ *
+*  ---- NOTE: ConWeave mechanism on NS-3 simulator. ----
+ * #A# The implementation might not be optimal unlike on switching ASIC.
+ *
+ * #B# We use "tag" instead of "header" class in NS-3. Since ConWeave header's extra overhead is
+ *     very small, we believe its effect on performance is negligible.
+ *
+ * 
+ * ---- TERMINOLOGY: ----
+ * Some terminologies are a bit different with the paper:
+ * 
+ * (1) Epoch (Big Loop): starts a new epoch whenever there is no remaining out-of-order packet of
+ * this message (epoch in paper)
+ *
+ * (2) Phase is the tag REROUTE in paper.
+ *     0: before rerouting, 1: after rerouting, within a specific epoch
+ *
+ * (3) Phase0Cache: to check there is no prior packet that arrive before REROUTE (see Appendix A)
+ *
+ * (4) "Stabilized" means no on-going packet reordering, so can start new rerouting
+ *
+ * (5) Reply + tag(INIT) = RTT_REPLY, Reply + tag(TAIL) = CLEAR in paper
+ *
+ * (6) Data + tag(INIT) = RTT_REQUEST, Data + tag(TAIL) = TAIL in paper
+ *
+ * ************************************************************************************************
+ */
+
+/*------ Stateful Objects ----*/
+struct conweaveTxState {
+    uint64_t _flowkey = 0;
+    bool _stabilized = true; /* make new connection always starts with epoch 1 */
+    Time _activeTime = CW_MIN_TIME;
+    Time _replyTimer = CW_MIN_TIME;
+    uint32_t _epoch = 0; /* by expiration at the beginning, the first packet begins with epoch 1 */
+    uint32_t _phase = 0; /* 0: before rerouting, 1: after rerouting */
+    uint32_t _pathId = CW_DEFAULT_32BIT; /* encoded current path ID (composition of uplinks) */
+    Time _tailTime = CW_MIN_TIME;        /* TAIL packet of current epoch (if available) */
+};
+
+struct conweaveRxState {
+    uint64_t _flowkey = 0;
+    Time _activeTime = CW_MIN_TIME; /* for auto-deletion (aging) - NS3 specific */
+    uint32_t _epoch = 1; /* Rx's epoch starts with 1, because Tx always starts with epoch 1 */
+    uint32_t _phase = 0;
+    Time _phase0TxTime = CW_MIN_TIME; /* TX_TSTAMP (at srcToR) of packets through OLD path  */
+    Time _phase0RxTime = CW_MIN_TIME; /* RX_TSTAMP (at dstToR) of packets through OLD path */
+    bool _phase0Cache =
+        false; /* to check whether there is prior packets that arrive before REROUTED */
+    Time _tailTime = CW_MIN_TIME; /* TX_TAIL_TSTAMP of current epoch */
+    bool _reordering = false;     /* For VOQ */
+};
+
+/**
+ * @brief Paths from this TxToR to one RxToR, and which ones are valid (not paused by a NOTIFY)
+ *
+ * `_order` is a permutation of the path indices whose first `_nValid` entries are the valid
+ * paths (`_pos` is its inverse), so that validating, invalidating and picking a random valid
+ * path are O(1).
+ */
+struct conweavePathSet {
+    std::vector<uint32_t> _paths;      // pathIds, ascending
+    std::vector<Time> _invalidTime;    // per path, valid again at this time
+    std::vector<uint32_t> _order;      // valid path indices first
+    std::vector<uint32_t> _pos;        // path index -> position in _order
+    uint32_t _nValid = 0;
+
+    bool IsValid(uint32_t idx) const { return _pos[idx] < _nValid; }
+    void SetValid(uint32_t idx, bool valid);
+};
+
+// a paused path, to re-validate at _time (stale if the pause was extended since)
+struct conweavePathExpiry {
+    Time _time;
+    uint32_t _rxToRId;
+    uint32_t _idx;
+};
+
+// follow PISA metadata concept
+struct conweaveTxMeta {
+    uint64_t pkt_flowkey = 0;
+    bool newConnection = false;
+    bool flagExpired = false;
+    bool flagReplyTimeout = false;
+    bool flagStabilized = false;
+    uint32_t epoch = 0;
+    uint32_t phase = 0;
+    uint32_t goodPath = CW_DEFAULT_32BIT;
+    bool foundGoodPath = false;
+    uint32_t currPath = CW_DEFAULT_32BIT;
+    uint64_t tailTime = 0;
+
+    /*-- REPLY Metadata --*/
+    uint32_t reply_flag;
+    uint32_t reply_epoch;
+    uint32_t reply_phase;
+};
+
+// follow PISA metadata concept
+struct conweaveRxMeta {
+    uint64_t pkt_flowkey = 0;
+    uint32_t pkt_pathId = 0;
+    uint32_t pkt_epoch = 0;
+    uint32_t pkt_phase = 0;
+    uint64_t pkt_timestamp_Tx = 0;
+    uint64_t pkt_timestamp_TAIL = 0;
+    uint32_t pkt_flagData = 0;
+    uint8_t pkt_ecnbits = 0; /* ECN bits */
+    bool newConnection = false;
+    uint8_t resultEpochMatch = 0; /* 1: new epoch, 2: prev epoch, 0: curr epoch */
+    Time phase0TxTime;
+    Time phase0RxTime;
+    bool flagOutOfOrder = false;
+    bool flagPhase0Cache = false; /* to check whether RTT info is available or not */
+    uint64_t tailTime = 0;
+    uint64_t timegapAtTx = 0;
+    uint64_t timeExpectedToFlush = 0;
+    bool flagEnqueue = false;
+};
+
+/*----------------------------*/
+// tag for data and request
+class ConWeaveDataTag : public Tag {
+   public:
+    ConWeaveDataTag();
+    void SetPathId(uint32_t pathId);
+    uint32_t GetPathId(void) const;
+    void SetHopCount(uint32_t hopCount);
+    uint32_t GetHopCount(void) const;
+    void SetEpoch(uint32_t epoch);
+    uint32_t GetEpoch(void) const;
+    void SetPhase(uint32_t phase);
+    uint32_t GetPhase(void) const;
+    void SetTimestampTx(uint64_t timestamp);
+    uint64_t GetTimestampTx(void) const;
+    void SetTimestampTail(uint64_t timestamp);
+    uint64_t GetTimestampTail(void) const;
+    void SetFlagData(uint32_t flag);
+    uint32_t GetFlagData(void) const;
+
+    /**
+     * @brief the fields of the tag, copied as is into its fixed slot of the packet
+     */
+    struct FixedState {
+        uint32_t pathId;
+        uint32_t hopCount;
+        uint32_t epoch;
+        uint32_t phase;
+        uint64_t timestampTx;    // departure time at TxToR
+        uint64_t timestampTail;  // time of last packet in previous epoch
+        uint32_t flagData;       // control flag
+    };
+    const FixedState& GetFixedState(void) const;
+    void SetFixedState(const FixedState& state);
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(TagBuffer i) const;
+    virtual void Deserialize(TagBuffer i);
+    virtual void Print(std::ostream& os) const;
+
+    friend std::ostream& operator<<(std::ostream& os, ConWeaveDataTag const& tag) {
+        return os << "m_pathId:" << tag.m_state.pathId << "\n"
+                  << "m_hopCount:" << tag.m_state.hopCount << "\n"
+                  << "m_epoch:" << tag.m_state.epoch << "\n"
+                  << "m_phase:" << tag.m_state.phase << "\n"
+                  << "m_timestampTx:" << tag.m_state.timestampTx << "\n"
+                  << "m_timestampTail:" << tag.m_state.timestampTail << "\n"
+                  << "m_flagData:" << tag.m_state.flagData << "\n"
+                  << std::endl;
+    }
+
+    enum ConWeaveDataTagFlag {
+        NONE = 0, /* Default, unused */
+        DATA = 1,
+        INIT = 2,
+        TAIL = 3,
+    };
+
+   private:
+    FixedState m_state;
+};
+
+// tag for reply
+class ConWeaveReplyTag : public Tag {
+   public:
+    ConWeaveReplyTag();
+    void SetFlagReply(uint32_t flagReply);
+    uint32_t GetFlagReply(void) const;
+    void SetEpoch(uint32_t epoch);
+    uint32_t GetEpoch(void) const;
+    void SetPhase(uint32_t phase);
+    uint32_t GetPhase(void) const;
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(TagBuffer i) const;
+    virtual void Deserialize(TagBuffer i);
+    virtual void Print(std::ostream& os) const;
+
+    friend std::ostream& operator<<(std::ostream& os, ConWeaveReplyTag const& tag) {
+        return os << "m_flagReply:" << tag.m_flagReply << "\n"
+                  << "m_epoch:" << tag.m_epoch << "\n"
+                  << "m_phase:" << tag.m_phase << "\n"
+                  << std::endl;
+    }
+
+    enum ConWeaveReplyTagFlag {
+        NONE = 0, /* Default, unused */
+        INIT = 1, /* RTT_REPLY in paper */
+        TAIL = 2, /* CLEAR in paper */
+    };
+
+   private:
+    uint32_t m_flagReply;
+    uint32_t m_epoch;
+    uint32_t m_phase;
+};
+
+// tag for congestion NOTIFY packet
+class ConWeaveNotifyTag : public Tag {
+   public:
+    ConWeaveNotifyTag();
+    void SetPathId(uint32_t pathId);
+    uint32_t GetPathId(void) const;
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(TagBuffer i) const;
+    virtual void Deserialize(TagBuffer i);
+    virtual void Print(std::ostream& os) const;
+
+    friend std::ostream& operator<<(std::ostream& os, ConWeaveNotifyTag const& tag) {
+        return os << "m_pathId:" << tag.m_pathId << std::endl;
+    }
+
+   private:
+    uint32_t m_pathId;  // path of DATA
+};
+
+/*----------------------------*/
+
+/**
+ * @brief ConWeave object is created for each ToR Switch
+ * -- path <-> outPort transformation --
+ * uint8_t pathp[4] = {uint8_t[port0], uint8_t[port1], uint8_t[port2], uint8_t[port3]}
+ * uint32_t path = *((uint32_t*) pathp);
+ * (uint8_t*)&path[0] -> port0
+ */
+
+class ConWeaveRouting : public Object {
+    friend class SwitchMmu;
+    friend class SwitchNode;
+    friend class ConWeaveVOQ;
+    friend class ConWeaveVOQTest;
+
+   public:
+    ConWeaveRouting();
+    ~ConWeaveRouting();
+    virtual void DoDispose();
+
+    /* static */
+    static TypeId GetTypeId(void);
+    static uint32_t GetOutPortFromPath(
+        const uint32_t& path,
+        const uint32_t& hopCount);  // decode outPort from path, given a hop's order
+    static void SetOutPortToPath(uint32_t& path, const uint32_t& hopCount,
+                                 const uint32_t& outPort);  // encode outPort to path
+
+    /* key */
+    static uint64_t GetFlowKey(uint32_t ip1, uint32_t ip2, uint16_t port1,
+                               uint16_t port2);                             // hashkey (4-tuple)
+    static uint32_t DoHash(const uint8_t* key, size_t len, uint32_t seed);  // hash function
+    uint32_t GetNumVOQ() { return m_voqMap.Size(); }
+    uint32_t GetVolumeVOQ() { return m_voqPool.GetPackets(); }
+    uint64_t GetVOQBytes() { return m_voqPool.GetBytes(); }
+    // VOQ objects, in use or free (ConWeaveVOQ::IsActive)
+    const std::deque<ConWeaveVOQ>& GetVOQs() { return m_voqs; }
+
+    /* main function */
+    void SendReply(Ptr<Packet> p, CustomHeader& ch, uint32_t flagReply, uint32_t pkt_epoch);
+    void SendNotify(Ptr<Packet> p, CustomHeader& ch, uint32_t pathId);
+    void RouteInput(Ptr<Packet> p, CustomHeader& ch);  // core function
+
+    ConWeaveVOQ& NewVOQ(uint64_t flowkey);  // reuses a free VOQ if any
+    void DeleteVOQ(uint64_t flowkey);  // used for callback when reorder queue is flushed
+    EventId m_agingEvent;
+    void AgingEvent();  // aging Tx/RxTableEntry (for cleaning and improve NS-3 simulation)
+
+    /* SET functions */
+    void SetConstants(Time extraReplyDeadline, Time extraVOQFlushTime, Time txExpiryTime,
+                      Time defaultVOQWaitingTime, Time pathPauseTime, bool pathAwareRerouting);
+    void SetSwitchInfo(bool isToR, uint32_t switch_id);
+    // age 1/steps of the Tx/Rx tables every agingTime/steps (1: whole tables at once)
+    void SetAgingSteps(uint32_t steps);
+    // charge the packets held in VOQs to the switch buffer (SetVOQBufferCallback)
+    void SetVOQBufferAccounting(bool enable) { m_voqBufferAccounting = enable; }
+
+    // callback of SwitchSend
+    void DoSwitchSend(Ptr<Packet> p, CustomHeader& ch, uint32_t outDev,
+                      uint32_t qIndex);                       // TxToR and Agg/CoreSw
+    void DoSwitchSendToDev(Ptr<Packet> p, CustomHeader& ch);  // only at RxToR
+
+    void CallbackByVOQFlush(uint64_t flowkey, uint32_t voqSize);  // used for callback in VOQ
+    // charge (enqueue) or release (flush) a VOQ packet, if the accounting is on;
+    // false: the switch buffer refused (and dropped) the packet
+    bool ChargeVOQBuffer(Ptr<Packet> p, CustomHeader& ch, bool enqueue) {
+        return !m_voqBufferAccounting || m_voqBufferCallback(p, ch, enqueue);
+    }
+
+    typedef Callback<void, Ptr<Packet>, CustomHeader&, uint32_t, uint32_t> SwitchSendCallback;
+    typedef Callback<void, Ptr<Packet>, CustomHeader&> SwitchSendToDevCallback;
+    typedef Callback<bool, Ptr<Packet>, CustomHeader&, bool> VOQBufferCallback;
+    void SetSwitchSendCallback(SwitchSendCallback switchSendCallback);  // set callback
+    void SetSwitchSendToDevCallback(
+        SwitchSendToDevCallback switchSendToDevCallback);  // set callback
+    void SetVOQBufferCallback(VOQBufferCallback voqBufferCallback);  // set callback
+
+    /* topological info (should be initialized in the beginning) */
+    void AddPath(uint32_t rxToRId, uint32_t pathId);  // a path from this TxToR to RxToR
+    const conweavePathSet& GetPathSet(uint32_t rxToRId) { return m_pathSets.at(rxToRId); }
+    void PausePath(uint32_t pathId, Time now);  // by a NOTIFY
+    void ExpirePathPauses(Time now);            // re-validate paths whose pause is over
+    std::map<uint32_t, uint64_t> m_rxToRId2BaseRTT;  // RxToRId -> BaseRTT between TORs(fixed)
+
+    /* statistics (logging) */
+    static StatCounter m_nReplyInitSent;      // number of reply sent
+    static StatCounter m_nReplyTailSent;      // number of reply sent
+    static StatCounter m_nTimelyInitReplied;  // number of reply timely arrived at TxToR
+    static StatCounter m_nTimelyTailReplied;  // number of reply timely arrived at TxToR
+    static StatCounter m_nNotifySent;         // number of feedback sent
+    static StatCounter m_nReRoute;            // number of rerouting path by Flowcut
+    static StatCounter m_nOutOfOrderPkts;     // number of OoO packets and queued at VOQ
+    static StatCounter m_nFlushVOQTotal;   // number of VOQ flush by timeout (can cause out-of-order)
+    static StatCounter m_nFlushVOQByTail;  // number of flushing VOQ natually (w/o out-of-order issue)
+    static LogHistogram m_historyVOQSize;  // VOQ size (pkts) at every flush
+
+   private:
+    // callback
+    SwitchSendCallback m_switchSendCallback;  // bound to SwitchNode::SwitchSend (for Request/UDP)
+    SwitchSendToDevCallback
+        m_switchSendToDevCallback;  // bound to SwitchNode::SendToDevContinue (for Probe, Reply)
+    VOQBufferCallback m_voqBufferCallback;  // bound to SwitchNode::ChargeVOQBuffer
+
+    // topology parameters
+    bool m_isToR;          // is ToR (leaf)
+    uint32_t m_switch_id;  // switch's nodeID
+    Ptr<UniformRandomVariable> m_rand;  // path choice, this switch's stream
+
+    // conweave parameters
+    Time m_extraReplyDeadline;  // additional term to reply deadline
+    Time m_extraVOQFlushTime;   // extra for uncertainty
+    Time m_txExpiryTime;        // flowlet timegap
+    Time m_defaultVOQWaitingTime;
+    Time m_pathPauseTime;  // time to pause path selection when getting ECN's feedback
+    bool m_pathAwareRerouting;
+    Time m_agingTime;  // aging time (e.g., 2ms)
+    uint32_t m_agingSteps;     // aging rounds per m_agingTime
+    uint32_t m_txAgingCursor;  // first slot of the next Tx aging round
+    uint32_t m_rxAgingCursor;  // first slot of the next Rx aging round
+
+    // paths (TxToR)
+    std::vector<conweavePathSet> m_pathSets;     // RxToRId -> paths
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t> >
+        m_pathId2Index;                          // pathId -> <RxToRId, path index>
+    std::deque<conweavePathExpiry> m_pathExpiry;  // time order, as m_pathPauseTime is constant
+
+    // local
+    FlowStateTable<conweaveTxState> m_conweaveTxTable;  // flowkey -> TxToR's stateful table
+    FlowStateTable<conweaveRxState> m_conweaveRxTable;  // flowkey -> RxToR's stateful table
+
+    // VOQ
+    FlowStateTable<ConWeaveVOQ*> m_voqMap;  // flowkey -> FIFO Queue (in m_voqs)
+    std::deque<ConWeaveVOQ> m_voqs;         // never moved: the flush events point to them
+    std::vector<ConWeaveVOQ*> m_freeVOQs;
+    ConWeaveVOQPool m_voqPool;              // packets of all VOQs
+    bool m_voqBufferAccounting;
+
+    static uint64_t debug_time;
+};
+
+}  // namespace ns3
+
+#endif
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2023 NUS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Chahwan Song <songch@comp.nus.edu.sg>
+ */
+
+#ifndef __CONWEAVE_VOQ_H__
+#define __CONWEAVE_VOQ_H__
+
+#include <deque>
+#include <vector>
+
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/custom-header.h"
+#include "ns3/event-id.h"
+#include "ns3/log-histogram.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/settings.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+class ConWeaveRouting;
+
+/**
+ * @brief Packet descriptors shared by the VOQs of a switch
+ *
+ * A queued packet is kept in a slot with the headers parsed when it arrived,
+ * and linked to the next packet of its VOQ.  Slots are recycled, so the VOQs
+ * stop allocating once the pool has grown to the peak occupancy.
+ */
+class ConWeaveVOQPool {
+   public:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Slot {
+        Ptr<Packet> packet;
+        CustomHeader ch;
+        uint32_t next;  // next slot of the same VOQ, or NONE
+    };
+
+    ConWeaveVOQPool();
+
+    uint32_t Alloc(Ptr<Packet> pkt, const CustomHeader& ch);
+    void Free(uint32_t index);
+    Slot& operator[](uint32_t index) { return m_slots[index]; }
+
+    uint32_t GetPackets() const { return m_packets; }  // packets in all VOQs
+    uint64_t GetBytes() const { return m_bytes; }
+
+   private:
+    std::deque<Slot> m_slots;  // never moved, so slots can be held across a flush
+    std::vector<uint32_t> m_free;
+    uint32_t m_packets;
+    uint64_t m_bytes;
+};
+
+/**
+ * @brief Virtual Output Queue, implemented in FIFO
+ * One additional feature - Timer for flushing and destroying by itself.
+ * The packets are chained in the pool of the owning ConWeaveRouting.
+ */
+class ConWeaveVOQ {
+    friend class ConWeaveRouting;
+
+   public:
+    ConWeaveVOQ();
+    ~ConWeaveVOQ();
+
+    // functions
+    void Set(ConWeaveRouting* routing, uint64_t flowkey, uint32_t dip, Time timeToFlush,
+             Time extraVOQFlushTime);  // setup
+    bool Enqueue(Ptr<Packet> pkt, CustomHeader& ch);  // enqueue pkt FIFO (false: dropped)
+    void FlushAllImmediately();              // flush all immediately (for scheduling)
+    void EnforceFlushAll();                  // enforce to flush the queue by timeout (makes OoO)
+    void RescheduleFlush(Time timeToFlush);  // reschedule timeout to flush
+    bool CheckEmpty();                       // check empty
+    uint32_t getQueueSize() const { return m_size; }  // get queue size
+    uint32_t getDIP() const { return m_dip; };
+    bool IsActive() const { return m_routing != nullptr; }  // false: free, to be recycled
+
+    // logging
+    static SignedLogHistogram m_flushEstErrorhistory;  // ns, at every flush rescheduled to now
+
+   private:
+    ConWeaveRouting* m_routing;  // owner (holds the pool), nullptr when free
+    uint64_t m_flowkey;          // flowkey (voqMap's key)
+    uint32_t m_dip;              // destination ip (for monitoring)
+    uint32_t m_head;             // per-flow FIFO queue, as slots of the pool
+    uint32_t m_tail;
+    uint32_t m_size;
+    EventId m_checkFlushEvent;  // check flush schedule is on-going (will be false once the queue
+                                // starts flushing)
+    Time m_extraVOQFlushTime; // extra flush time (for network uncertainty) -- for debugging
+};
+
+}  // namespace ns3
+
+#endif
\ No newline at end of file
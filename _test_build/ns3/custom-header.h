@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef CUSTOM_HEADER_H
+#define CUSTOM_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/int-header.h"
+#include "ns3/packet.h"
+
+namespace ns3 {
+/**
+ * \ingroup ipv4
+ *
+ * \brief Custom packet header
+ */
+class CustomHeader : public Header 
+{
+public:
+  /**
+   * \brief Construct a null custom header
+   */
+  CustomHeader ();
+  CustomHeader (uint32_t _headerType);
+  /**
+   * \enum EcnType
+   * \brief ECN Type defined in \RFC{3168}
+   */
+  enum EcnType
+    {
+      // Prefixed with "ECN" to avoid name clash (bug 1723)
+      ECN_NotECT = 0x00,
+      ECN_ECT1 = 0x01,
+      ECN_ECT0 = 0x02,
+      ECN_CE = 0x03
+    }; 
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  uint32_t brief, headerType, getInt;
+  enum HeaderType{
+	L2_Header = 1,
+	L3_Header = 2,
+	L4_Header = 4
+  };
+
+  // ppp header
+  uint16_t pppProto;
+
+  // IPv4 header
+  enum FlagsE {
+    DONT_FRAGMENT = (1<<0),
+    MORE_FRAGMENTS = (1<<1)
+  };
+  uint16_t m_payloadSize; //!< payload size
+  uint16_t ipid; //!< identification
+  uint32_t m_tos : 8; //!< TOS, also used as DSCP + ECN value
+  uint32_t m_ttl : 8; //!< TTL
+  uint32_t l3Prot: 8;  //!< Protocol
+  uint32_t ipv4Flags : 3; //!< flags
+  uint16_t m_fragmentOffset;  //!< Fragment offset
+  uint32_t sip; //!< source address
+  uint32_t dip; //!< destination address
+  uint16_t m_checksum; //!< checksum
+  uint16_t m_headerSize; //!< IP header size
+
+  union {
+	  struct {
+		  uint16_t sport;        //!< Source port
+		  uint16_t dport;   //!< Destination port
+		  uint32_t seq;  //!< Sequence number
+		  uint32_t ack;       //!< ACK number
+		  uint8_t length;             //!< Length (really a uint4_t) in words.
+		  uint8_t tcpFlags;              //!< Flags (really a uint6_t)
+		  uint16_t windowSize;        //!< Window size
+		  uint16_t urgentPointer;     //!< Urgent pointer
+		  uint8_t optionBuf[32]; // buffer for storing raw options
+	  } tcp;
+	  struct {
+		  uint16_t sport;        //!< Source port
+		  uint16_t dport;   //!< Destination port
+		  uint16_t payload_size;
+		  // SeqTsHeader
+		  uint16_t pg;
+		  uint32_t seq;
+		  IntHeader ih;
+	  } udp;
+	  // CnHeader
+	  struct {
+		  uint16_t fid;
+		  uint8_t qIndex;
+		  uint16_t qfb;
+		  uint8_t ecnBits;
+		  uint16_t total;
+	  } cnp;
+	  // qbbHeader
+	  struct {
+		  uint16_t sport, dport;
+		  uint16_t flags;
+		  uint16_t pg;
+		  uint32_t seq; // the qbb sequence number.
+		  IntHeader ih;
+		  uint32_t irnNack;
+		  uint16_t irnNackSize;
+	  } ack;
+	  // PauseHeader
+	  struct {
+		  uint32_t time;
+		  uint32_t qlen;
+		  uint8_t qIndex;
+	  } pfc;
+  };
+
+  uint8_t GetIpv4EcnBits (void) const;
+
+  /**
+   * \brief p->PeekHeader (*this), reusing the headers parsed at a previous hop
+   *
+   * A full parse (L2_Header | L3_Header | L4_Header, brief, with INT) is
+   * attached to p as its PacketHeaderCache: the next hops copy it instead
+   * of deserializing the packet again, until its bytes change.  Other
+   * parses are neither cached nor served from the cache.
+   */
+  void PeekCached (Ptr<Packet> p);
+  /**
+   * \returns the parse cached in p, or 0 if it has none.  It is shared with
+   * the copies of p: only update it after Packet::PeekWritableData, along
+   * with the bytes (see CustomHeaderView).
+   */
+  static CustomHeader *GetCache (Ptr<Packet> p);
+
+  static uint32_t GetAckSerializedSize(void);
+  static uint32_t GetUdpHeaderSize(void); // include udp, seqTs, INT
+  static uint32_t GetStaticWholeHeaderSize(void); // ppp + ip + udp + int
+};
+
+/**
+ * \ingroup ipv4
+ *
+ * \brief In-place access to the headers of a packet laid out like
+ * CustomHeader: ppp, ipv4, then udp, SeqTs and INT for data packets
+ *
+ * The view unshares the header bytes of the packet once, when it is
+ * created.  Each update then writes the few bytes involved, keeps the
+ * IPv4 checksum valid and updates the parse cached in the packet (see
+ * CustomHeader::PeekCached), instead of removing and adding the headers.
+ * The view is only valid until the packet is changed in any other way.
+ */
+class CustomHeaderView
+{
+public:
+  CustomHeaderView (Ptr<Packet> p);
+
+  uint8_t GetTos (void) const;
+  /**
+   * \param ecn the new ECN bits (CustomHeader::EcnType)
+   */
+  void SetEcn (uint8_t ecn);
+  uint8_t GetTtl (void) const;
+  void SetTtl (uint8_t ttl);
+  uint8_t GetProtocol (void) const;
+  /**
+   * \brief Push a hop to the INT header of a udp data packet
+   */
+  void PushIntHop (uint64_t time, uint64_t bytes, uint32_t qlen, uint64_t rate);
+
+private:
+  /**
+   * \brief Write one byte of the ipv4 header and fix up its checksum
+   * (RFC 1624).  A zero checksum, i.e. checksums disabled, stays zero.
+   */
+  void SetIpv4Byte (uint32_t offset, uint8_t value);
+
+  Ptr<Packet> m_packet;
+  uint8_t *m_ipv4; //!< start of the ipv4 header
+  uint32_t m_ipv4Size; //!< size of the ipv4 header
+  CustomHeader *m_cache; //!< parse cached in the packet, or 0
+};
+
+} // namespace ns3
+
+
+#endif /* CUSTOM_HEADER_H */
+
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DRILL_ENGINE_H
+#define DRILL_ENGINE_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "ns3/ecmp-fib.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+/**
+ * @brief DRILL(d, m) port choice
+ *
+ * The least loaded of d random next hops and of the m least loaded ones
+ * of the previous choice for the same ECMP group, which become the m
+ * least loaded of these candidates.  Remembered ports win ties, sampled
+ * ports are distinct, and all next hops are candidates when d >= their
+ * number.  The memory is a dense array indexed by EcmpGroup::id, and the
+ * candidates are kept between calls, so a choice allocates nothing.
+ */
+class DrillEngine {
+   public:
+    DrillEngine() : m_rng(CreateObject<UniformRandomVariable>()) {}
+
+    /** @brief Draw the samples from a fixed stream, reproducible from the run's seed */
+    void SetStream(int64_t stream) { m_rng->SetStream(stream); }
+
+    /**
+     * @param d ports sampled
+     * @param m ports remembered per group (0: none)
+     * @param load queue length of a port, called once per candidate
+     * @returns the chosen port
+     */
+    template <typename Load>
+    uint32_t Choose(const EcmpGroup &group, uint32_t d, uint32_t m, Load load);
+
+   private:
+    Ptr<UniformRandomVariable> m_rng;
+    std::vector<uint32_t> m_best;  // <group id * m + i, port> (UINT32_MAX: none)
+    std::vector<std::pair<uint32_t, uint32_t> > m_candidates;  // <load, port>, reused
+};
+
+template <typename Load>
+uint32_t DrillEngine::Choose(const EcmpGroup &group, uint32_t d, uint32_t m, Load load) {
+    uint32_t n = group.size();
+    if (m_best.size() < (group.id + 1) * m) {
+        m_best.resize((group.id + 1) * m, UINT32_MAX);
+    }
+    uint32_t *best = m ? &m_best[group.id * m] : NULL;
+
+    // candidates: the remembered ports first, so that they win ties
+    m_candidates.clear();
+    for (uint32_t i = 0; i < m && best[i] != UINT32_MAX; i++) {
+        m_candidates.push_back(std::make_pair(load(best[i]), best[i]));
+    }
+    uint32_t nSampled = m_candidates.size();
+    if (d >= n) {
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t port = group.nexthops[i];
+            m_candidates.push_back(std::make_pair(load(port), port));
+        }
+    } else {
+        for (uint32_t s = 0; s < d; s++) {
+            uint32_t port;
+            bool drawn;
+            do {  // d distinct ports
+                port = group.nexthops[m_rng->GetInteger(0, n - 1)];
+                drawn = false;
+                for (uint32_t i = nSampled; i < m_candidates.size(); i++) {
+                    drawn |= m_candidates[i].second == port;
+                }
+            } while (drawn);
+            m_candidates.push_back(std::make_pair(load(port), port));
+        }
+    }
+
+    // stable insertion sort by load: few candidates, and no allocation
+    for (uint32_t i = 1; i < m_candidates.size(); i++) {
+        std::pair<uint32_t, uint32_t> c = m_candidates[i];
+        uint32_t j = i;
+        for (; j > 0 && m_candidates[j - 1].first > c.first; j--) {
+            m_candidates[j] = m_candidates[j - 1];
+        }
+        m_candidates[j] = c;
+    }
+
+    // remember the m least loaded distinct ports
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < m_candidates.size() && kept < m; i++) {
+        uint32_t port = m_candidates[i].second;
+        if (std::find(best, best + kept, port) == best + kept) {
+            best[kept++] = port;
+        }
+    }
+    for (uint32_t i = kept; i < m; i++) {
+        best[i] = UINT32_MAX;
+    }
+    return m_candidates[0].second;
+}
+
+}  // namespace ns3
+
+#endif /* DRILL_ENGINE_H */
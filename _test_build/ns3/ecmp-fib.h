@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ECMP_FIB_H
+#define ECMP_FIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief A set of equal-cost next hops (indices of devices)
+ *
+ * Mod () is hash % nexthops.size () computed with a precomputed
+ * reciprocal (Lemire's fastmod), which is exact for any 32-bit hash.
+ */
+struct EcmpGroup {
+    std::vector<int> nexthops;
+    uint64_t reciprocal;  // 2^64 / size, rounded up
+    uint32_t id;          // dense index of the group in its EcmpFib, for per-group state
+
+    EcmpGroup(const std::vector<int>& hops, uint32_t groupId)
+        : nexthops(hops),
+          reciprocal(UINT64_C(0xFFFFFFFFFFFFFFFF) / hops.size() + 1),
+          id(groupId) {}
+
+    uint32_t size() const { return nexthops.size(); }
+
+    uint32_t Mod(uint32_t hash) const {
+        uint64_t lowbits = reciprocal * hash;
+        return ((__uint128_t)lowbits * nexthops.size()) >> 64;
+    }
+
+    /** \returns the next hop picked by hash */
+    int Pick(uint32_t hash) const { return nexthops[Mod(hash)]; }
+};
+
+/**
+ * @brief Forwarding table from a host IP to its ECMP group
+ *
+ * Hosts are addressed by Settings::node_id_to_ip, so the node id
+ * embedded in the IP directly indexes an array of groups.  Groups
+ * are deduplicated: the destinations reached through the same ports
+ * share one EcmpGroup, so the table stays small and cache resident.
+ * Groups are never freed before the table is destroyed, so a group
+ * returned by Lookup () stays valid when routes change.
+ */
+class EcmpFib {
+   public:
+    EcmpFib() {}
+
+    /** Append intf to the next hops of dip */
+    void Add(uint32_t dip, int intf);
+    /** Replace the next hops of dip (none: remove the entry) */
+    void Set(uint32_t dip, const std::vector<int>& nexthops);
+    /** Remove all entries (groups are kept for reuse) */
+    void Clear();
+
+    /** \returns the number of groups, an upper bound of EcmpGroup::id */
+    uint32_t GetNGroups() const { return m_groups.size(); }
+
+    /**
+     * \returns the group of dip, or NULL if there is no route.  Only host
+     * addresses (11.x.y.1) are routed: another address whose node id bits
+     * match an entry is a miss.
+     */
+    const EcmpGroup* Lookup(uint32_t dip) const {
+        uint32_t idx = Index(dip);
+        return IsHostIp(dip) && idx < m_fib.size() ? m_fib[idx] : NULL;
+    }
+
+   private:
+    static bool IsHostIp(uint32_t dip) { return (dip & 0xff0000ff) == 0x0b000001; }  // Settings::node_id_to_ip
+    static uint32_t Index(uint32_t dip) { return (dip >> 8) & 0xffff; }            // Settings::ip_to_node_id
+    const EcmpGroup* Intern(const std::vector<int>& nexthops);
+
+    std::vector<const EcmpGroup*> m_fib;                     // node id -> group
+    std::deque<EcmpGroup> m_groups;                          // never reallocated
+    std::map<std::vector<int>, const EcmpGroup*> m_groupOf;  // next hops -> group
+};
+
+}  // namespace ns3
+
+#endif /* ECMP_FIB_H */
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef EVENT_IMPL_H
+#define EVENT_IMPL_H
+
+#include <stdint.h>
+#ifdef NS3_EVENT_PROFILER
+#include <string.h>
+#endif
+#include "simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief a simulation event
+ *
+ * Each subclass of this base class represents a simulation event. The
+ * EventImpl::Invoke method will be invoked by the simulation engine
+ * when the time associated to this event expires. This class is
+ * obviously (there are Ref and Unref methods) reference-counted and
+ * most subclasses are usually created by one of the many Simulator::Schedule
+ * methods.
+ */
+class EventImpl : public SimpleRefCount<EventImpl>
+{
+public:
+  EventImpl ();
+  virtual ~EventImpl () = 0;
+  /**
+   * Called by the simulation engine to notify the event that it has expired.
+   */
+  void Invoke (void);
+  /**
+   * Marks the event as 'canceled'. The event will not be removed from
+   * the event list but the simulation engine will check its canceled status
+   * before calling Invoke.
+   */
+  void Cancel (void);
+  /**
+   * \returns true if the event has been canceled.
+   *
+   * Invoked by the simulation engine before calling Invoke.
+   */
+  bool IsCancelled (void);
+#ifdef NS3_EVENT_PROFILER
+  /**
+   * \returns the code run by Notify (the function, or the member
+   * function resolved on the object), for EventProfiler; 0 if unknown
+   */
+  virtual const void *GetProfileTarget (void) const;
+#endif
+
+protected:
+  virtual void Notify (void) = 0;
+#ifdef NS3_EVENT_PROFILER
+  template <typename F>
+  static const void *ProfileFunctionTarget (F function);
+  template <typename T, typename MEM>
+  static const void *ProfileMemberTarget (T &obj, MEM function);
+#endif
+
+private:
+  bool m_cancel;
+};
+
+#ifdef NS3_EVENT_PROFILER
+template <typename F>
+const void *
+EventImpl::ProfileFunctionTarget (F function)
+{
+  const void *target;
+  memcpy (&target, &function, sizeof (target));
+  return target;
+}
+
+template <typename T, typename MEM>
+const void *
+EventImpl::ProfileMemberTarget (T &obj, MEM function)
+{
+#if defined(__GNUC__)
+  // Itanium C++ ABI: {function address, or 1 + vtable offset; this adjustment}
+  struct
+  {
+    uintptr_t ptr;
+    intptr_t adj;
+  } mfp;
+  if (sizeof (function) != sizeof (mfp))
+    {
+      return 0;
+    }
+  memcpy (&mfp, &function, sizeof (mfp));
+  if (mfp.ptr & 1)
+    {
+      const char *self = reinterpret_cast<const char *> (&obj) + mfp.adj;
+      const char *vtable = *reinterpret_cast<const char *const *> (self);
+      return *reinterpret_cast<const void *const *> (vtable + mfp.ptr - 1);
+    }
+  return reinterpret_cast<const void *> (mfp.ptr);
+#else
+  return 0;
+#endif
+}
+#endif /* NS3_EVENT_PROFILER */
+
+} // namespace ns3
+
+#endif /* EVENT_IMPL_H */
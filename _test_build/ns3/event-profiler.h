@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * \file
+ * \ingroup events
+ * Wall-clock cost of the simulation events, per handler and per module.
+ *
+ * Only built with ./waf configure --enable-event-profiler (which defines
+ * NS3_EVENT_PROFILER); otherwise this header declares nothing and the
+ * simulator runs the events exactly as before.
+ */
+
+#ifdef NS3_EVENT_PROFILER
+
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include "event-impl.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief Per-handler event cost accounting
+ *
+ * DefaultSimulatorImpl::ProcessOneEvent times every event with the time
+ * stamp counter and charges the cycles to the code the event runs
+ * (EventImpl::GetProfileTarget: the function, or the member function
+ * resolved on its object), or to the event type when that is unknown.
+ * Handlers are named from the symbol table, or by SetLabel().
+ *
+ * At Simulator::Destroy the top handlers and the cost per module (shared
+ * library) are printed on stderr.  Environment:
+ *  - NS_EVENT_PROFILE_TOP: number of handlers listed (default 25)
+ *  - NS_EVENT_PROFILE_FOLDED: file to write "module;handler cycles"
+ *    lines to, the folded-stack input of flamegraph.pl
+ *
+ * Not thread-safe: only the default (sequential) simulator is profiled.
+ */
+class EventProfiler
+{
+public:
+  static uint64_t GetCycles (void)
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc ();
+#else
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+  }
+
+  /**
+   * \brief Charge `cycles` to the handler at `target`, or to the event
+   * type `type` when `target` is null
+   *
+   * Both are taken from the event before it is invoked: running the
+   * handler may destroy the object the event refers to.
+   */
+  static void Record (const void *target, const std::type_info &type, uint64_t cycles);
+
+  /**
+   * \brief Name the handler at `target` (a function address, as returned
+   * by EventImpl::GetProfileTarget) in the report
+   */
+  static void SetLabel (const void *target, const std::string &label);
+  template <typename F>
+  static void SetFunctionLabel (F function, const std::string &label);
+
+  /**
+   * \brief Print the report and write the folded-stack file, then reset
+   */
+  static void Report (void);
+};
+
+template <typename F>
+void
+EventProfiler::SetFunctionLabel (F function, const std::string &label)
+{
+  const void *target;
+  memcpy (&target, &function, sizeof (target));
+  SetLabel (target, label);
+}
+
+} // namespace ns3
+
+#endif /* NS3_EVENT_PROFILER */
+
+#endif /* EVENT_PROFILER_H */
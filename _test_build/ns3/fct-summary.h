@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FCT_SUMMARY_H
+#define FCT_SUMMARY_H
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "ns3/log-histogram.h"
+#include "ns3/trace-writer.h"
+
+namespace ns3 {
+
+/**
+ * @brief Online FCT and slowdown percentiles per flow size bucket and PG
+ *
+ * Replaces the post-processing of the per-flow FCT file
+ * (fctAnalysis.py, analysis/plot_fct.py) for runs where that file would
+ * be too large.  Slowdown is FCT / standalone FCT, clamped to 1 like the
+ * scripts do.
+ */
+class FctSummary {
+   public:
+    /**
+     * @param sizeEdges upper bounds (bytes, inclusive) of the size buckets,
+     * ascending; a last bucket takes the larger flows
+     */
+    explicit FctSummary(const std::vector<uint64_t> &sizeEdges);
+
+    void Record(uint64_t size, uint32_t pg, uint64_t fct, uint64_t standaloneFct);
+
+    /**
+     * @brief Add the columns written by Write() to a trace
+     */
+    static void DeclareColumns(TraceWriter *out);
+    /**
+     * @brief Write one row per (PG, size bucket) with flows, stamped `now`
+     * (ns), covering all the flows recorded so far
+     */
+    void Write(TraceWriter *out, uint64_t now) const;
+
+   private:
+    struct Bucket {
+        LogHistogram fct;       // ns
+        LogHistogram slowdown;  // 1/1000
+    };
+
+    std::vector<uint64_t> m_sizeEdges;
+    std::map<std::pair<uint32_t, uint32_t>, Bucket> m_buckets;  // (pg, size bucket)
+};
+
+}  // namespace ns3
+
+#endif /* FCT_SUMMARY_H */
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_HASH_H
+#define FLOW_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * @brief MurmurHash3 (x86_32) of flow keys, as used for ECMP and QP placement
+ *
+ * Every function returns exactly MurmurHash3_x86_32 (key, len, seed), the
+ * hash SwitchNode::EcmpHash, ConWeaveRouting::DoHash and ns3::Hash32 (seed
+ * 0x8BADF00D) have always computed, so routing decisions do not change.
+ *
+ * Murmur3x1 / Murmur3x3 hash keys of one / three 32-bit words (a path id,
+ * a {sip, dip, sport | dport << 16} tuple) without the generic loop.
+ * Murmur3x3Batch hashes many tuples at once with the widest back-end the
+ * CPU supports: AVX2 (8 lanes), SSE4.2 (4 lanes, SSE4.1 multiplies) or
+ * scalar.  The CRC32 instruction of SSE4.2 computes a different function,
+ * so it is not used.
+ */
+class FlowHash {
+   public:
+    enum Backend { SCALAR = 0, SSE42, AVX2 };
+
+    static const uint32_t QP_SEED = 0x8BADF00D;  // seed of ns3::Hash32
+
+    static uint32_t Murmur3(const uint8_t* key, size_t len, uint32_t seed);
+
+    static inline uint32_t Murmur3x1(uint32_t w0, uint32_t seed) {
+        uint32_t h = Mix(seed, w0);
+        return Finalize(h, 4);
+    }
+
+    static inline uint32_t Murmur3x3(uint32_t w0, uint32_t w1, uint32_t w2, uint32_t seed) {
+        uint32_t h = Mix(seed, w0);
+        h = Mix(h, w1);
+        h = Mix(h, w2);
+        return Finalize(h, 12);
+    }
+
+    /**
+     * out[i] = Murmur3x3 (words[3i], words[3i + 1], words[3i + 2], seeds[i])
+     * for i < n; seeds == NULL hashes every key with seed.
+     */
+    static void Murmur3x3Batch(const uint32_t* words, const uint32_t* seeds, uint32_t seed,
+                               uint32_t n, uint32_t* out);
+
+    /** Back-end of Murmur3x3Batch: the best one the CPU supports by default */
+    static Backend GetBackend();
+    /** Select a back-end (capped to what the CPU supports); returns the one in use */
+    static Backend SetBackend(Backend backend);
+    static Backend GetBestBackend();
+
+    // body round of one 32-bit block
+    static inline uint32_t Mix(uint32_t h, uint32_t k) {
+        k *= 0xcc9e2d51;
+        k = (k << 15) | (k >> 17);
+        k *= 0x1b873593;
+        h ^= k;
+        h = (h << 13) | (h >> 19);
+        return h * 5 + 0xe6546b64;
+    }
+
+    static inline uint32_t Finalize(uint32_t h, uint32_t len) {
+        h ^= len;
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        h ^= h >> 16;
+        return h;
+    }
+
+   private:
+    static Backend m_backend;
+};
+
+}  // namespace ns3
+
+#endif /* FLOW_HASH_H */
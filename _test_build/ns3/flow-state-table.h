@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_STATE_TABLE_H
+#define FLOW_STATE_TABLE_H
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Flat hash table from a 64-bit flow key to an inline state record
+ *
+ * Open addressing with linear probing over a power-of-two array of
+ * {key, state} slots, so a lookup usually touches a single cache line
+ * instead of walking the nodes of a std::map.  Erase uses backward-shift
+ * deletion (no tombstones), which keeps probe sequences short however
+ * many flows come and go.
+ *
+ * operator[] behaves like std::map::operator[]: a missing key is inserted
+ * with a default-constructed T.  Any insertion may rehash, so references
+ * returned earlier must not be kept across another insertion; looking up
+ * a present key never rehashes.
+ *
+ * Sweep () visits a window of slots and erases the entries matching a
+ * predicate; stepping the window round the table ages it incrementally.
+ */
+template <typename T>
+class FlowStateTable {
+   public:
+    FlowStateTable() : m_size(0), m_shift(64) {}
+
+    T &operator[](uint64_t key) {
+        T *found = Find(key);
+        if (found) {
+            return *found;
+        }
+        // only an insertion grows the table, a hit keeps references valid
+        if (m_slots.empty() || (m_size + 1) * 4 > m_slots.size() * 3) {
+            Grow();
+        }
+        uint32_t mask = Mask();
+        uint32_t i = Home(key);
+        while (m_slots[i].used) {
+            i = (i + 1) & mask;
+        }
+        m_slots[i].used = true;
+        m_slots[i].key = key;
+        m_slots[i].value = T();
+        m_size++;
+        return m_slots[i].value;
+    }
+
+    /** \returns the state of key, or 0 if absent */
+    T *Find(uint64_t key) {
+        if (m_size == 0) {
+            return 0;
+        }
+        uint32_t mask = Mask();
+        for (uint32_t i = Home(key); m_slots[i].used; i = (i + 1) & mask) {
+            if (m_slots[i].key == key) {
+                return &m_slots[i].value;
+            }
+        }
+        return 0;
+    }
+
+    bool Erase(uint64_t key) {
+        if (m_size == 0) {
+            return false;
+        }
+        uint32_t mask = Mask();
+        for (uint32_t i = Home(key); m_slots[i].used; i = (i + 1) & mask) {
+            if (m_slots[i].key == key) {
+                EraseAt(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Erase the entries of slots [start, start + count) for which
+     * expired (state) is true.
+     * \returns the slot where the next window starts (0 after the last one)
+     */
+    template <typename Pred>
+    uint32_t Sweep(uint32_t start, uint32_t count, Pred expired) {
+        uint32_t cap = Capacity();
+        if (start >= cap) {
+            return 0;
+        }
+        uint32_t end = (count >= cap - start) ? cap : start + count;
+        for (uint32_t i = start; i < end;) {
+            if (m_slots[i].used && expired(m_slots[i].value)) {
+                // a later entry may have been shifted into slot i
+                EraseAt(i);
+            } else {
+                i++;
+            }
+        }
+        return end == cap ? 0 : end;
+    }
+
+    uint32_t Size() const { return m_size; }
+    uint32_t Capacity() const { return (uint32_t)m_slots.size(); }
+
+   private:
+    struct Slot {
+        uint64_t key;
+        bool used;
+        T value;
+        Slot() : key(0), used(false), value() {}
+    };
+
+    uint32_t Mask() const { return (uint32_t)m_slots.size() - 1; }
+
+    // Fibonacci hashing: flow keys pack IPs and ports, so mix before masking
+    uint32_t Home(uint64_t key) const {
+        return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> m_shift);
+    }
+
+    void EraseAt(uint32_t hole) {
+        uint32_t mask = Mask();
+        uint32_t j = hole;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!m_slots[j].used) {
+                break;
+            }
+            // move slot j back unless its home lies cyclically in (hole, j]
+            uint32_t home = Home(m_slots[j].key);
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                m_slots[hole] = std::move(m_slots[j]);
+                hole = j;
+            }
+        }
+        m_slots[hole].used = false;
+        m_slots[hole].value = T();
+        m_size--;
+    }
+
+    void Grow() {
+        uint32_t cap = m_slots.empty() ? 256 : Capacity() * 2;
+        assert(cap != 0);
+        std::vector<Slot> old(cap);
+        old.swap(m_slots);
+        m_shift = 64;
+        for (uint32_t c = cap; c > 1; c >>= 1) {
+            m_shift--;
+        }
+        uint32_t mask = Mask();
+        for (typename std::vector<Slot>::iterator it = old.begin(); it != old.end(); ++it) {
+            if (!it->used) {
+                continue;
+            }
+            uint32_t i = Home(it->key);
+            while (m_slots[i].used) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = std::move(*it);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    uint32_t m_size;   // number of used slots
+    uint32_t m_shift;  // 64 - log2 (capacity)
+};
+
+}  // namespace ns3
+
+#endif /* FLOW_STATE_TABLE_H */
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_TRACE_H
+#define FLOW_TRACE_H
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * @brief Header of a binary flow trace (all fields in host byte order)
+ *
+ * The file is this header followed by flowCount FlowTraceRecord, sorted by
+ * start time; flows starting at the same time keep the order of the text
+ * flow file they come from.  traffic_gen/flow_to_bin.py converts the text
+ * flow files of traffic_gen.py.
+ */
+struct FlowTraceHeader {
+    char magic[8];        // "NS3FLOW\0"
+    uint32_t byteOrder;   // 0x01020304
+    uint32_t version;
+    uint32_t recordSize;  // sizeof(FlowTraceRecord)
+    uint32_t reserved;
+    uint64_t flowCount;
+    uint32_t minHost;  // lowest and highest node id of the sources and destinations
+    uint32_t maxHost;
+    double firstStart;  // s
+    double lastStart;   // s
+};
+
+struct FlowTraceRecord {
+    double startTime;  // s, as in the text file
+    uint32_t src;
+    uint32_t dst;
+    uint32_t size;  // bytes
+    uint32_t pg;
+};
+
+/**
+ * @brief Read-only memory mapping of a binary flow trace
+ *
+ * The records are read in place, in order; Release() lets the kernel drop
+ * the pages already consumed, so that a trace of any length costs a few
+ * pages of resident memory.
+ */
+class FlowTraceFile {
+   public:
+    static const uint32_t kVersion = 1;
+
+    FlowTraceFile();
+    ~FlowTraceFile();
+
+    /**
+     * @brief Whether `path` starts with the magic of a binary flow trace
+     */
+    static bool IsBinary(const std::string &path);
+
+    /**
+     * @returns false, with `error` set, if the file cannot be mapped or is
+     * not a valid trace
+     */
+    bool Open(const std::string &path, std::string &error);
+    void Close();
+
+    const FlowTraceHeader &GetHeader() const { return *m_header; }
+    uint64_t GetCount() const { return m_header->flowCount; }
+    const FlowTraceRecord &Get(uint64_t i) const { return m_records[i]; }
+    /**
+     * @returns false, with `error` set, if record `i` starts before 0 or
+     * before record i - 1, or has a node outside of [minHost, maxHost] of
+     * the header
+     */
+    bool Check(uint64_t i, std::string &error) const;
+    /**
+     * @brief Records before `i` will not be read again
+     */
+    void Release(uint64_t i);
+
+   private:
+    void *m_map;
+    size_t m_length;
+    const FlowTraceHeader *m_header;
+    const FlowTraceRecord *m_records;
+    size_t m_released;  // bytes from the start of the mapping
+};
+
+}  // namespace ns3
+
+#endif /* FLOW_TRACE_H */
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOWLET_TABLE_H
+#define FLOWLET_TABLE_H
+
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "ns3/flow-state-table.h"
+#include "ns3/nstime.h"
+#include "ns3/settings.h"
+
+namespace ns3 {
+
+/**
+ * @brief QpKey -> Flowlet store of a flowlet-switching ToR (CONGA, Letflow)
+ *
+ * Flowlets live in a slab (a deque of entries recycled through a free
+ * list), found through a FlowStateTable index, so creating and aging a
+ * flowlet never calls new/delete.
+ *
+ * Expiry uses a timing wheel whose slots are one aging period wide.  An
+ * entry refreshed since the last Expire () is in the current slot and
+ * cannot be idle for longer than the aging period, so Expire () only
+ * examines the entries of the previous slot: those idle for longer are
+ * erased, the others (refreshed exactly at the previous tick) move on to
+ * the current slot.  With Expire () called every aging period this
+ * erases exactly the flowlets a full scan of the table would.
+ */
+class FlowletTable {
+   public:
+    FlowletTable();
+
+    /** \returns the flowlet of key, or NULL */
+    Flowlet* Find(uint64_t key);
+    /** Create the flowlet of key (which must be absent), active at now */
+    Flowlet* Insert(uint64_t key, Time now);
+    /** Set flowlet->_activeTime; the only way to refresh a flowlet */
+    void SetActive(Flowlet* flowlet, Time now);
+
+    /** Erase the flowlets idle for longer than agingTime; call every agingTime */
+    void Expire(Time now, Time agingTime);
+
+    uint32_t GetSize() const { return m_index.Size(); }
+
+   private:
+    static const uint32_t NIL = UINT32_MAX;
+
+    struct Entry : public Flowlet {
+        uint64_t key;
+        uint32_t id;    // position in m_slab
+        uint32_t slot;  // wheel slot (0/1), NIL when free
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    void Link(Entry& e, uint32_t slot);
+    void Unlink(Entry& e);
+
+    std::deque<Entry> m_slab;           // never reallocated: Flowlet* stay valid
+    std::vector<uint32_t> m_free;       // free entries of m_slab
+    FlowStateTable<uint32_t> m_index;   // key -> position in m_slab
+    uint32_t m_head[2];                 // wheel slots, lists of entries
+    uint32_t m_current;                 // slot refreshed entries go to
+};
+
+}  // namespace ns3
+
+#endif /* FLOWLET_TABLE_H */
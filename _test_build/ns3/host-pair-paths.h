@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HOST_PAIR_PATHS_H
+#define HOST_PAIR_PATHS_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Up link of the routing graph
+ */
+struct RouteLink {
+    uint32_t next;   // node id
+    uint64_t delay;  // ns
+    uint64_t bw;     // bps
+};
+
+/**
+ * @brief Edge-to-edge delay, TX delay and bandwidth between every pair of hosts
+ *
+ * Dense [dst host][src host] tables (hosts numbered in node order), filled by
+ * the BFS rooted at each dst.  The RTT and BDP of a pair are derived on
+ * demand, from the BFS rooted at the higher node id of the pair, as both
+ * directions share them.  They keep the values of the initial topology
+ * (Freeze), whereas Bw follows the link failures.
+ */
+class HostPairPaths {
+   public:
+    typedef std::vector<std::pair<uint32_t, uint32_t>> Hops;  // (node, next hop)
+
+    HostPairPaths();
+
+    /**
+     * @param isHost node id -> whether the node is a host
+     */
+    void Init(const std::vector<bool> &isHost);
+    uint32_t GetNodeCount() const { return m_hostIndex.size(); }
+    /**
+     * @returns the node ids of the hosts, in node order
+     */
+    const std::vector<uint32_t> &GetHosts() const { return m_hosts; }
+    void Freeze() { m_frozen = true; }
+
+    bool Has(uint32_t src, uint32_t dst) const {
+        return src != dst && src < m_hostIndex.size() && dst < m_hostIndex.size() &&
+               m_hostIndex[src] != UINT32_MAX && m_hostIndex[dst] != UINT32_MAX;
+    }
+    uint64_t Bw(uint32_t src, uint32_t dst) const { return m_bw[At(src, dst)]; }
+    uint64_t Rtt(uint32_t a, uint32_t b) const {
+        size_t i = At(std::min(a, b), std::max(a, b));
+        return m_delay[i] * 2 + m_txDelay[i];
+    }
+    uint64_t Bdp(uint32_t a, uint32_t b) const {
+        return Rtt(a, b) * m_baseBw[At(std::min(a, b), std::max(a, b))] / 1000000000 / 8;
+    }
+    /**
+     * @brief Highest Rtt and Bdp over all the pairs of hosts, kept along
+     * with the tables
+     */
+    uint64_t GetMaxRtt() const;
+    uint64_t GetMaxBdp() const;
+
+    /**
+     * @brief BFS rooted at `host` (node id): fills the host's own row of the
+     * tables, and the next hops towards it into `hops`, so that the hosts can
+     * be processed in parallel
+     * @param links node id -> up links, in the order of the routing entries
+     * @param payloadSize bytes of a data packet, for the TX delay
+     */
+    void CalculateRoute(const std::vector<std::vector<RouteLink>> &links,
+                        const std::vector<bool> &isSwitch, uint32_t payloadSize, uint32_t host,
+                        Hops &hops);
+    /**
+     * @brief CalculateRoute for every host, on `nThreads` threads
+     * @param hops the next hops towards each host, in the order of GetHosts()
+     */
+    void CalculateRoutes(const std::vector<std::vector<RouteLink>> &links,
+                         const std::vector<bool> &isSwitch, uint32_t payloadSize,
+                         uint32_t nThreads, std::vector<Hops> &hops);
+
+   private:
+    size_t At(uint32_t src, uint32_t dst) const {
+        return (size_t)m_hostIndex[dst] * m_hosts.size() + m_hostIndex[src];
+    }
+
+    std::vector<uint32_t> m_hostIndex;  // node id -> host number, UINT32_MAX for switches
+    std::vector<uint32_t> m_hosts;      // host number -> node id
+    bool m_frozen;
+    std::vector<uint64_t> m_delay, m_txDelay, m_baseBw;  // initial topology
+    std::vector<uint64_t> m_bw;
+    // per dst host, highest Rtt and Bdp of the pairs whose row it is
+    std::vector<uint64_t> m_rowMaxRtt, m_rowMaxBdp;
+};
+
+}  // namespace ns3
+
+#endif /* HOST_PAIR_PATHS_H */
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng (2005).
+ *
+ * Far-future events are appended, unsorted, to the Top list. When the
+ * near-future events run out, Top is spread over a rung of buckets whose
+ * width is derived from the range of the events it holds; a bucket that
+ * is still too crowded is spread over a finer child rung, and a small
+ * enough bucket is sorted into Bottom, from which events are dequeued.
+ * Only the events of one bucket are ever sorted, which keeps the
+ * amortized cost of Insert and RemoveNext independent of the number of
+ * pending events, as long as the delays are not all identical.
+ *
+ * Events with the same timestamp always end up in the same bucket, so
+ * they are dequeued in uid order exactly as with the other schedulers.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  struct Rung
+  {
+    std::vector<Bucket> buckets;
+    // number of buckets in use (buckets.size () only ever grows)
+    uint32_t nBuckets;
+    // timestamp at the start of the first bucket
+    uint64_t start;
+    // duration of a bucket
+    uint64_t width;
+    // index of the first bucket which has not been drained yet
+    uint32_t current;
+    // number of events in the rung
+    uint32_t count;
+  };
+
+  void InitRung (uint32_t rung, uint64_t start, uint64_t width, uint32_t nBuckets);
+  inline uint64_t CurrentStart (const Rung &rung) const;
+  void InsertBottom (const Event &ev);
+  void RefillBottom (void);
+  void Clear (void);
+
+  // unsorted events at or after m_topStart
+  Bucket m_top;
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  uint64_t m_topStart;
+
+  // rungs 0..m_nRungs-1 are active, rung 0 is the coarsest
+  std::vector<Rung> m_rungs;
+  uint32_t m_nRungs;
+
+  // sorted in decreasing order so that the next event is at the back
+  Bucket m_bottom;
+
+  // number of events in the queue
+  uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
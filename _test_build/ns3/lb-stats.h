@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LB_STATS_H
+#define LB_STATS_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "ns3/log-histogram.h"
+#include "ns3/trace-writer.h"
+
+namespace ns3 {
+
+/**
+ * @brief Run statistics of the load balancers, in bounded memory
+ *
+ * The routing modules keep counters and histograms (static members, as
+ * their other statistics) instead of a history of every event; they are
+ * registered here by name, then written together as one row per call of
+ * Write().  Columns: time, then one per counter and, per histogram,
+ * count, avg, min, p50, p90, p99 and max, named "<name>.<column>".
+ */
+class LbStats {
+   public:
+    static void AddCounter(const std::string &name, const uint32_t *value);
+    static void AddCounter(const std::string &name, const uint64_t *value);
+    static void AddCounter(const std::string &name, const std::atomic<uint64_t> *value);
+    static void AddHistogram(const std::string &name, const LogHistogram *histogram);
+    static void AddHistogram(const std::string &name, const SignedLogHistogram *histogram);
+
+    /**
+     * @brief Add the columns written by Write() to a trace, once all the
+     * statistics are registered, and list them in a comment
+     */
+    static void DeclareColumns(TraceWriter *out);
+    /**
+     * @brief Write the current values, stamped `now` (ns), cumulative since
+     * the start of the run
+     */
+    static void Write(TraceWriter *out, uint64_t now);
+
+    static void Clear();  // forget the registered statistics
+
+   private:
+    struct Entry {
+        std::string name;
+        const uint32_t *counter32;
+        const uint64_t *counter64;
+        const std::atomic<uint64_t> *atomic64;
+        const LogHistogram *histogram;
+        const SignedLogHistogram *signedHistogram;
+    };
+    static std::vector<Entry> &Entries();
+    static void Add(const Entry &entry);
+};
+
+}  // namespace ns3
+
+#endif /* LB_STATS_H */
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LOG_HISTOGRAM_H
+#define LOG_HISTOGRAM_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Histogram of unsigned values with a bounded relative error
+ *
+ * Log-linear buckets, as in HDR histograms: every power of two is split
+ * into 2^kSubBits equal sub-buckets, so a quantile is known within
+ * 2^-kSubBits (< 1%) of its value, whatever the range, with O(1)
+ * recording.  The counters grow up to the bucket of the largest value:
+ * 3072 of them (24 KB) below 2^30, e.g. an FCT under a second in ns, and
+ * at most 7424 (58 KB) for the whole 64-bit range.
+ */
+class LogHistogram {
+   public:
+    static const uint32_t kSubBits = 7;
+
+    LogHistogram();
+
+    void Record(uint64_t value);
+
+    uint64_t GetCount() const { return m_count; }
+    uint64_t GetMin() const { return m_min; }
+    uint64_t GetMax() const { return m_max; }
+    double GetMean() const { return m_count ? (double)m_sum / m_count : 0; }
+    /**
+     * @brief Value of rank floor(count * p) (0-based) in the sorted values,
+     * i.e. the percentile the analysis scripts compute, within the bucket
+     * precision
+     */
+    uint64_t GetQuantile(double p) const;
+    /**
+     * @brief Value of rank `rank` (0-based, < count) in the sorted values
+     */
+    uint64_t GetAtRank(uint64_t rank) const;
+
+    /** @brief Bucket of a value, one per value below 2^kSubBits */
+    static uint32_t BucketOf(uint64_t value);
+    /** @brief Smallest value of a bucket */
+    static uint64_t BucketLow(uint32_t bucket);
+
+   private:
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count;
+    long double m_sum;
+    uint64_t m_min;
+    uint64_t m_max;
+};
+
+/**
+ * @brief LogHistogram of signed values: the negative ones are kept by
+ * magnitude in a second histogram
+ */
+class SignedLogHistogram {
+   public:
+    void Record(int64_t value);
+
+    uint64_t GetCount() const { return m_negative.GetCount() + m_positive.GetCount(); }
+    int64_t GetMin() const;
+    int64_t GetMax() const;
+    double GetMean() const;
+    int64_t GetQuantile(double p) const;  // see LogHistogram::GetQuantile
+
+   private:
+    LogHistogram m_negative;  // -value
+    LogHistogram m_positive;  // value >= 0
+};
+
+}  // namespace ns3
+
+#endif /* LOG_HISTOGRAM_H */
@@ -0,0 +1,311 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef PACKET_TAG_LIST_H
+#define PACKET_TAG_LIST_H
+
+#include <stdint.h>
+#include <string.h>
+#include <ostream>
+#include "ns3/type-id.h"
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+namespace ns3 {
+
+class Tag;
+
+/**
+ * \ingroup constants
+ * \brief Tag maximum size
+ * The maximum size (in bytes) of a Tag is stored
+ * in this constant.
+ */
+#define PACKET_TAG_MAX_SIZE 512
+
+/**
+ * \ingroup constants
+ * \brief Number of tag types which can be kept in a fixed slot
+ */
+#define PACKET_TAG_FIXED_SLOTS 4
+/**
+ * \ingroup constants
+ * \brief Size (in bytes) of the fixed slots area of every packet
+ */
+#define PACKET_TAG_FIXED_SIZE 48
+
+/**
+ * \brief The packet tags of a packet
+ *
+ * Tags are normally kept in a copy-on-write list shared between the
+ * copies of a packet, which is searched by TypeId on every Peek and
+ * copied on every Remove.  The few tags which are set on every packet
+ * at every hop (FlowIdTag, ConWeaveDataTag) can instead be given a
+ * fixed slot with RegisterFixedTag: the state of such a tag is copied
+ * as is into an area embedded in the packet, and Add, Peek and Remove
+ * become a table lookup, a bit test and a memcpy, through the same
+ * Packet::AddPacketTag, PeekPacketTag and RemovePacketTag calls.
+ *
+ * The fixed area makes every packet PACKET_TAG_FIXED_SIZE bytes larger
+ * and is copied with the packet, so it is sized for these tags only;
+ * every other tag, and a tag registered once the area is full, stays
+ * in the list.
+ */
+class PacketTagList 
+{
+public:
+  struct TagData {
+    uint8_t data[PACKET_TAG_MAX_SIZE];
+    struct TagData *next;
+    TypeId tid;
+#ifdef NS3_MTP
+    std::atomic<uint32_t> count;
+#else
+    uint32_t count;
+#endif
+  };
+
+  /**
+   * Copy the state of a tag kept in a fixed slot out of the slot.
+   */
+  typedef void (*FixedLoad) (Tag &tag, uint8_t const *data);
+
+  inline PacketTagList ();
+  inline PacketTagList (PacketTagList const &o);
+  inline PacketTagList &operator = (PacketTagList const &o);
+  inline ~PacketTagList ();
+
+  void Add (Tag const&tag) const;
+  bool Remove (Tag &tag);
+  bool Peek (Tag &tag) const;
+  inline void RemoveAll (void);
+
+  const struct PacketTagList::TagData *Head (void) const;
+
+  /**
+   * Keep the tags of type T in a fixed slot rather than in the list.
+   * Meant to be called from T::GetTypeId, so that the slot exists
+   * before the first tag of this type is added.  T provides a
+   * trivially copyable T::FixedState with
+   * \code
+   *   const FixedState &GetFixedState (void) const;
+   *   void SetFixedState (const FixedState &state);
+   * \endcode
+   * which Add, Peek and Remove copy instead of serializing the tag.
+   *
+   * \param tid the TypeId of T
+   * \returns tid
+   */
+  template <typename T>
+  static TypeId RegisterFixedTag (TypeId tid);
+
+  /**
+   * \returns a bitmask of the fixed slots holding a tag
+   */
+  uint32_t GetFixedMask (void) const;
+  /**
+   * \param slot a slot set in GetFixedMask
+   * \param tid the TypeId of the tag in the slot
+   * \param load the function copying the slot into a tag of this type
+   * \returns the state of the tag
+   */
+  const uint8_t *GetFixed (uint32_t slot, TypeId &tid, FixedLoad &load) const;
+
+private:
+  typedef void (*FixedStore) (Tag const &tag, uint8_t *data);
+
+  struct FixedSlot {
+    TypeId tid;
+    uint16_t offset;
+    uint16_t size;
+    FixedStore store;
+    FixedLoad load;
+  };
+
+  // size of the table of fixed slots indexed by the low bits of a TypeId uid
+  enum { FIXED_INDEX_SIZE = 64 };
+
+  static TypeId DoRegisterFixedTag (TypeId tid, uint32_t size,
+                                    FixedStore store, FixedLoad load);
+  template <typename T>
+  static void StoreState (Tag const &tag, uint8_t *data);
+  template <typename T>
+  static void LoadState (Tag &tag, uint8_t const *data);
+
+  inline int32_t FindFixedSlot (TypeId tid) const;
+  inline void CopyFixed (PacketTagList const &o);
+  inline void ReleaseList (void);
+  bool Remove (TypeId tid);
+  struct PacketTagList::TagData *AllocData (void) const;
+  void FreeData (struct TagData *data) const;
+
+  static struct FixedSlot g_fixedSlots[PACKET_TAG_FIXED_SLOTS];
+  // slot + 1 of the tag whose TypeId uid has these low bits, 0 if none
+#ifdef NS3_MTP
+  static std::atomic<uint8_t> g_fixedIndex[FIXED_INDEX_SIZE];
+#else
+  static uint8_t g_fixedIndex[FIXED_INDEX_SIZE];
+#endif
+  static uint32_t g_nFixedSlots;
+  static uint32_t g_fixedSize;
+
+#ifdef NS3_MTP
+  static thread_local struct PacketTagList::TagData *g_free;
+  static thread_local uint32_t g_nfree;
+#else
+  static struct PacketTagList::TagData *g_free;
+  static uint32_t g_nfree;
+#endif
+
+  struct TagData *m_next;
+  // bit i is set when slot i of m_fixed holds a tag
+  uint32_t m_fixedMask;
+  uint8_t m_fixed[PACKET_TAG_FIXED_SIZE];
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3 {
+
+PacketTagList::PacketTagList ()
+  : m_next (),
+    m_fixedMask (0)
+{
+}
+
+PacketTagList::PacketTagList (PacketTagList const &o)
+  : m_next (o.m_next)
+{
+  if (m_next != 0)
+    {
+      m_next->count++;
+    }
+  CopyFixed (o);
+}
+
+PacketTagList &
+PacketTagList::operator = (PacketTagList const &o)
+{
+  // self assignment
+  if (this == &o)
+    {
+      return *this;
+    }
+  if (m_next != o.m_next)
+    {
+      ReleaseList ();
+      m_next = o.m_next;
+      if (m_next != 0)
+        {
+          m_next->count++;
+        }
+    }
+  CopyFixed (o);
+  return *this;
+}
+
+PacketTagList::~PacketTagList ()
+{
+  ReleaseList ();
+}
+
+template <typename T>
+TypeId
+PacketTagList::RegisterFixedTag (TypeId tid)
+{
+  return DoRegisterFixedTag (tid, sizeof (typename T::FixedState),
+                             &PacketTagList::StoreState<T>, &PacketTagList::LoadState<T>);
+}
+
+template <typename T>
+void
+PacketTagList::StoreState (Tag const &tag, uint8_t *data)
+{
+  memcpy (data, &static_cast<T const &> (tag).GetFixedState (), sizeof (typename T::FixedState));
+}
+
+template <typename T>
+void
+PacketTagList::LoadState (Tag &tag, uint8_t const *data)
+{
+  typename T::FixedState state;
+  memcpy (&state, data, sizeof (state));
+  static_cast<T &> (tag).SetFixedState (state);
+}
+
+int32_t
+PacketTagList::FindFixedSlot (TypeId tid) const
+{
+  uint32_t index = g_fixedIndex[tid.GetUid () & (FIXED_INDEX_SIZE - 1)];
+  if (index != 0 && g_fixedSlots[index - 1].tid == tid)
+    {
+      return index - 1;
+    }
+  return -1;
+}
+
+void
+PacketTagList::CopyFixed (PacketTagList const &o)
+{
+  m_fixedMask = o.m_fixedMask;
+  for (uint32_t mask = m_fixedMask; mask != 0; mask &= mask - 1)
+    {
+      const struct FixedSlot &slot = g_fixedSlots[__builtin_ctz (mask)];
+      memcpy (m_fixed + slot.offset, o.m_fixed + slot.offset, slot.size);
+    }
+}
+
+void
+PacketTagList::RemoveAll (void)
+{
+  ReleaseList ();
+  m_fixedMask = 0;
+}
+
+void
+PacketTagList::ReleaseList (void)
+{
+  struct TagData *prev = 0;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
+    {
+      if (--cur->count > 0) 
+        {
+          break;
+        }
+      if (prev != 0) 
+        {
+          FreeData (prev);
+        }
+      prev = cur;
+    }
+  if (prev != 0) 
+    {
+      FreeData (prev);
+    }
+  m_next = 0;
+}
+
+} // namespace ns3
+
+#endif /* PACKET_TAG_LIST_H */
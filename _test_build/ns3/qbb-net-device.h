@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+* Copyright (c) 2006 Georgia Tech Research Corporation, INRIA
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* Author: Yibo Zhu <yibzh@microsoft.com>
+*/
+#ifndef QBB_NET_DEVICE_H
+#define QBB_NET_DEVICE_H
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/broadcom-node.h"
+#include "ns3/qbb-channel.h"
+//#include "ns3/fivetuple.h"
+#include "ns3/event-id.h"
+#include "ns3/broadcom-egress-queue.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/rdma-queue-pair.h"
+#include <vector>
+#include<map>
+#include <queue>
+#include <unordered_map>
+#include <ns3/rdma.h>
+
+namespace ns3 {
+
+/**
+ * Egress of a NIC: the ACK queue, then the QPs of m_qpGrp in round robin.
+ *
+ * QPs are not scanned on every dequeue.  Each QP of the group is
+ *  - ready: it has bytes left and m_nextAvail has passed; it is in the
+ *    ready bitmap of its PG, and a paused PG simply has its bitmap skipped,
+ *  - waiting: it has bytes left but m_nextAvail is in the future; it is in
+ *    a heap keyed by m_nextAvail, which also gives the next wakeup time,
+ *  - idle: nothing to send, or bound by its (fixed) window or IRN state.
+ * UpdateQp () re-files a QP whenever its bytes left, window or m_nextAvail
+ * may have changed (sent a packet, ACK/NACK, timeout, rate change).
+ * GetNextQindex () walks the ready bitmaps from m_rrlast + 1 on, so it
+ * picks the same QP as a round-robin scan of all QPs would.  Finished QPs
+ * are compacted out of the group once they are half of it.
+ */
+class RdmaEgressQueue : public Object{
+public:
+	static const uint32_t qCnt = 8;
+	static const uint32_t MIN_COMPACT = 64; // finished QPs before compacting the group
+	static uint32_t ack_q_idx;
+	uint32_t m_mtu;
+	int m_qlast;
+	uint32_t m_rrlast;
+	Ptr<DropTailQueue> m_ackQ; // highest priority queue
+	Ptr<RdmaQueuePairGroup> m_qpGrp; // queue pairs
+
+	// callback for get next packet
+	typedef Callback<Ptr<Packet>, Ptr<RdmaQueuePair> > RdmaGetNxtPkt;
+	RdmaGetNxtPkt m_rdmaGetNxtPkt;
+
+	static TypeId GetTypeId (void);
+	RdmaEgressQueue();
+	Ptr<Packet> DequeueQindex(int qIndex);
+  int GetNextQindex(bool paused[], bool allowLongFlow = true);
+	int GetLastQueue();
+	uint32_t GetNBytes(uint32_t qIndex);
+	uint32_t GetFlowCount(void);
+	Ptr<RdmaQueuePair> GetQp(uint32_t i);
+	void RecoverQueue(uint32_t i);
+	void EnqueueHighPrioQ(Ptr<Packet> p);
+	void CleanHighPrio(TracedCallback<Ptr<const Packet>, uint32_t> dropCb);
+
+	// re-file qp after its bytes left, window or m_nextAvail changed
+	void UpdateQp(Ptr<RdmaQueuePair> qp);
+	// soonest m_nextAvail in the future of a QP with bytes left (max time if none)
+	Time GetNextAvail();
+	// PFC pause / resume of a PG, for the pause time accounting
+	void PfcPause(uint32_t pg);
+	void PfcResume(uint32_t pg);
+
+	TracedCallback<Ptr<const Packet>, uint32_t> m_traceRdmaEnqueue;
+	TracedCallback<Ptr<const Packet>, uint32_t> m_traceRdmaDequeue;
+
+private:
+	enum QpState { QP_IDLE = 0, QP_READY, QP_WAITING };
+	struct Wakeup {
+		int64_t time;   // m_nextAvail of the QP
+		uint32_t idx;
+		uint32_t stamp; // entry is stale unless equal to m_qpStamp[idx]
+		bool operator> (const Wakeup &o) const { return time > o.time; }
+	};
+
+	void Sync();
+	void Classify(uint32_t idx);
+	void Expire();
+	bool CanSend(Ptr<RdmaQueuePair> qp);
+	void SetReady(uint32_t idx, uint32_t pg);
+	void ClearReady(uint32_t idx, uint32_t pg);
+	int FindReady(uint32_t from, uint32_t to, const uint32_t *pgs, uint32_t nPgs);
+
+	uint32_t m_grpGeneration;                 // m_qpGrp->m_generation the state below is for
+	std::vector<uint8_t> m_qpState;           // per QP index
+	std::vector<uint32_t> m_qpStamp;
+	std::vector<Time> m_readySince;
+	std::vector<uint64_t> m_ready[qCnt];      // per PG bitmap of ready QPs
+	uint32_t m_nReady[qCnt];
+	std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup> > m_wakeups;
+	Time m_pauseStart[qCnt];
+};
+
+/**
+ * \class QbbNetDevice
+ * \brief A Device for a IEEE 802.1Qbb Network Link.
+ */
+class QbbNetDevice : public PointToPointNetDevice 
+{
+public:
+  static const uint32_t qCnt = 8;	// Number of queues/priorities used
+  static const uint32_t pCnt = 257;	// Number of ports used
+  static const uint32_t fCnt = 128; // Max number of flows on a NIC, for TX and RX respectively. TX+RX=fCnt*2
+  static const uint32_t maxHop = 1; // Max hop count in the network. should not exceed 16 
+
+  static TypeId GetTypeId (void);
+
+  QbbNetDevice ();
+  virtual ~QbbNetDevice ();
+
+  /**
+   * Receive a packet from a connected PointToPointChannel.
+   *
+   * This is to intercept the same call from the PointToPointNetDevice
+   * so that the pause messages are honoured without letting
+   * PointToPointNetDevice::Receive(p) know
+   *
+   * @see PointToPointNetDevice
+   * @param p Ptr to the received packet.
+   */
+  virtual void Receive (Ptr<Packet> p);
+
+  /**
+   * Send a packet to the channel by putting it to the queue
+   * of the corresponding priority class
+   *
+   * @param packet Ptr to the packet to send
+   * @param dest Unused
+   * @param protocolNumber Protocol used in packet
+   */
+  virtual bool Send(Ptr<Packet> packet, const Address &dest, uint16_t protocolNumber);
+  virtual bool SwitchSend (uint32_t qIndex, Ptr<Packet> packet, CustomHeader &ch);
+
+  /**
+   * Get the size of Tx buffer available in the device
+   *
+   * @return buffer available in bytes
+   */
+  //virtual uint32_t GetTxAvailable(unsigned) const;
+
+  /**
+   * TracedCallback hooks
+   */
+  void ConnectWithoutContext(const CallbackBase& callback);
+  void DisconnectWithoutContext(const CallbackBase& callback);
+
+  bool Attach (Ptr<QbbChannel> ch);
+
+   virtual Ptr<Channel> GetChannel (void) const;
+
+   void SetQueue (Ptr<BEgressQueue> q);
+   Ptr<BEgressQueue> GetQueue ();
+   virtual bool IsQbb(void) const;
+   void NewQp(Ptr<RdmaQueuePair> qp);
+   void ReassignedQp(Ptr<RdmaQueuePair> qp);
+   void TriggerTransmit(void);
+   void UpdateQp(Ptr<RdmaQueuePair> qp);
+
+   bool IsQbbEnabled(void) { return m_qbbEnabled; }
+
+   uint32_t SendPfc(uint32_t qIndex, uint32_t type); // type: 0 = pause, 1 = resume
+
+   TracedCallback<Ptr<const Packet>, uint32_t> m_traceEnqueue;
+   TracedCallback<Ptr<const Packet>, uint32_t> m_traceDequeue;
+   TracedCallback<Ptr<const Packet>, uint32_t> m_traceDrop;
+   TracedCallback<uint32_t> m_tracePfc; // 0: resume, 1: pause
+ protected:
+
+   //Ptr<Node> m_node;
+
+   bool TransmitStart (Ptr<Packet> p);
+
+   virtual void DoDispose(void);
+
+   /// Reset the channel into READY state and try transmit again
+   virtual void TransmitComplete(void);
+
+   /// Look for an available packet and send it using TransmitStart(p)
+   virtual void DequeueAndTransmit(void);
+
+   /// Resume a paused queue and call DequeueAndTransmit()
+   virtual void Resume(unsigned qIndex);
+
+   /**
+   * The queues for each priority class.
+   * @see class Queue
+   * @see class InfiniteQueue
+   */
+   Ptr<BEgressQueue> m_queue;
+
+   Ptr<QbbChannel> m_channel;
+
+   //pfc
+   bool m_qbbEnabled;	//< PFC behaviour enabled
+   bool m_qcnEnabled;
+   bool m_dynamicth;
+   uint32_t m_pausetime;	//< Time for each Pause
+   bool m_paused[qCnt];	//< Whether a queue paused
+   EventId m_resumeEvt[qCnt];
+
+   //qcn
+
+   /* RP parameters */
+   EventId  m_nextSend;		//< The next send event
+   /* State variable for rate-limited queues */
+
+   //qcn
+
+   struct ECNAccount{
+     Ipv4Address source;
+     uint32_t qIndex;
+     uint32_t port;
+     uint8_t ecnbits;
+     uint16_t qfb;
+     uint16_t total;
+  };
+
+  std::vector<ECNAccount> *m_ecn_source;
+
+public:
+	Ptr<RdmaEgressQueue> m_rdmaEQ;
+	void RdmaEnqueueHighPrioQ(Ptr<Packet> p);
+
+	// CPEM: Credit-based PFC Enhancement Module
+	void CpemSetEffectiveRate(DataRate rate);
+	DataRate CpemGetEffectiveRate() const;
+	void CpemResetRate();  // Reset to line rate
+	
+protected:
+	DataRate m_cpemEffectiveRate;  // CPEM controlled effective rate
+	bool m_cpemRateLimited;        // Whether CPEM rate limiting is active
+  uint32_t m_txQueueContext;      // Queue/PG associated with the current packet being transmitted
+  EventId m_cpemRecoveryEvent;    // Auto-recovery timer for stale CPEM rate limits
+  Time m_cpemNextSendTime;        // Earliest eligible send time for long-flow pacing
+
+  void CpemRecoveryTimeout();
+  bool CpemShouldPaceQueue(uint32_t queueOrPg) const;
+  bool CpemLongQueueBlocked() const;
+  Time CpemGetNextEligibleTime() const;
+  void CpemUpdatePacingAfterSend(Ptr<Packet> p, uint32_t queueOrPg);
+
+public:
+	// callback for processing packet in RDMA
+	typedef Callback<int, Ptr<Packet>, CustomHeader&> RdmaReceiveCb;
+	RdmaReceiveCb m_rdmaReceiveCb;
+	// callback for link down
+	typedef Callback<void, Ptr<QbbNetDevice> > RdmaLinkDownCb;
+	RdmaLinkDownCb m_rdmaLinkDownCb;
+	// callback for sent a packet
+	typedef Callback<void, Ptr<RdmaQueuePair>, Ptr<Packet>, Time> RdmaPktSent;
+	RdmaPktSent m_rdmaPktSent;
+
+	Ptr<RdmaEgressQueue> GetRdmaQueue();
+	void TakeDown(); // take down this device
+	void UpdateNextAvail(Time t);
+
+	TracedCallback<Ptr<const Packet>, Ptr<RdmaQueuePair> > m_traceQpDequeue; // the trace for printing dequeue
+};
+
+} // namespace ns3
+
+#endif // QBB_NET_DEVICE_H
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RDMA_DATA_HEADER_H
+#define RDMA_DATA_HEADER_H
+
+#include <stdint.h>
+
+#include "ns3/buffer.h"
+#include "ns3/header.h"
+#include "ns3/int-header.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \brief Header template of the data packets of one QP
+ *
+ * Serializes to exactly the bytes of PppHeader + Ipv4Header + UdpHeader +
+ * SeqTsHeader as RdmaHw used to add them one by one.  The PPP/IPv4/UDP
+ * part is serialized once per QP in Init (); only the fields that change
+ * between packets (IP total length and identification, UDP length,
+ * sequence number, INT) are patched by Set (), so a data packet needs a
+ * single AddHeader.
+ *
+ * Receivers keep parsing the bytes with CustomHeader or the individual
+ * headers; Print () decodes the four headers for ascii traces.
+ */
+class RdmaDataHeader : public Header {
+   public:
+    RdmaDataHeader();
+
+    /**
+     * Serialize the per-QP part of the template.
+     */
+    void Init(Ipv4Address sip, Ipv4Address dip, uint16_t sport, uint16_t dport, uint16_t pg);
+    bool IsInitialized(void) const;
+
+    /**
+     * Patch the per-packet fields.
+     * \param seq sequence number (SeqTsHeader)
+     * \param ipid IP identification
+     * \param payloadSize bytes following the SeqTsHeader
+     */
+    void Set(uint32_t seq, uint16_t ipid, uint32_t payloadSize);
+
+    static TypeId GetTypeId(void);
+    virtual TypeId GetInstanceTypeId(void) const;
+    virtual void Print(std::ostream &os) const;
+    virtual uint32_t GetSerializedSize(void) const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+
+   private:
+    // PPP (14, padded as an Ethernet header) + IPv4 (20) + UDP (8)
+    static const uint32_t kMaxPrefixSize = 48;
+
+    uint8_t m_prefix[kMaxPrefixSize];  // serialized PPP/IPv4/UDP headers
+    uint32_t m_prefixSize;             // 0 until Init ()
+    uint32_t m_ipOffset;               // offset of the IPv4 header in m_prefix
+    uint32_t m_udpOffset;              // offset of the UDP header in m_prefix
+    uint32_t m_seq;
+    uint16_t m_pg;
+    IntHeader m_ih;
+};
+
+}  // namespace ns3
+
+#endif /* RDMA_DATA_HEADER_H */
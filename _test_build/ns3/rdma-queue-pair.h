@@ -0,0 +1,288 @@
+#ifndef RDMA_QUEUE_PAIR_H
+#define RDMA_QUEUE_PAIR_H
+
+#include <ns3/custom-header.h>
+#include <ns3/data-rate.h>
+#include <ns3/event-id.h>
+#include <ns3/int-header.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/object.h>
+#include <ns3/packet.h>
+#include <ns3/rdma-data-header.h>
+#include <ns3/selective-packet-queue.h>
+
+#include <vector>
+
+namespace ns3 {
+
+enum CcMode {
+    CC_MODE_DCQCN = 1,
+    CC_MODE_HPCC = 3,
+    CC_MODE_TIMELY = 7,
+    CC_MODE_DCTCP = 8,
+    CC_MODE_UNDEFINED = 0,
+};
+
+class IrnSackManager {
+   private:
+    std::list<std::pair<uint32_t, uint32_t>> m_data;
+
+   public:
+    int socketId{-1};
+
+    IrnSackManager();
+    IrnSackManager(int flow_id);
+    void sack(uint32_t seq, uint32_t size);  // put blocks
+    size_t discardUpTo(uint32_t seq);        // return number of blocks removed
+    bool IsEmpty();
+    bool blockExists(uint32_t seq, uint32_t size);  // query if block exists inside SACK table
+    bool peekFrontBlock(uint32_t *pseq, uint32_t *psize);
+    size_t getSackBufferOverhead();  // get buffer overhead
+
+    friend std::ostream &operator<<(std::ostream &os, const IrnSackManager &im);
+};
+
+/**
+ * @brief Per-QP DCQCN parameters for differentiated congestion control.
+ * When MEDU flow classification is enabled, short flows and long flows
+ * can use different DCQCN parameters to optimize performance.
+ */
+struct DcqcnParams {
+    double m_g;                       // EWMA gain (feedback weight)
+    double m_rateOnFirstCNP;          // fraction of rate on first CNP
+    bool m_EcnClampTgtRate;           // clamp target rate
+    double m_rpgTimeReset;            // rate increase timer (us)
+    double m_rateDecreaseInterval;    // rate decrease check interval (us)
+    uint32_t m_rpgThreshold;          // fast recovery times threshold
+    double m_alpha_resume_interval;   // alpha update interval (us)
+    DataRate m_rai;                   // rate of additive increase
+    DataRate m_rhai;                  // rate of hyper-additive increase
+    DataRate m_minRate;               // minimum sending rate
+
+    DcqcnParams()
+        : m_g(1.0 / 256),
+          m_rateOnFirstCNP(1.0),
+          m_EcnClampTgtRate(false),
+          m_rpgTimeReset(300.0),
+          m_rateDecreaseInterval(4.0),
+          m_rpgThreshold(1),
+          m_alpha_resume_interval(1.0),
+          m_rai(DataRate("40Mb/s")),
+          m_rhai(DataRate("100Mb/s")),
+          m_minRate(DataRate("100Mb/s")) {}
+};
+
+class RdmaQueuePair : public Object {
+   public:
+    Time startTime;
+    Ipv4Address sip, dip;
+    uint16_t sport, dport;
+    uint64_t m_size;
+    uint64_t snd_nxt, snd_una;  // next seq to send, the highest unacked seq
+    uint16_t m_pg;
+    uint16_t m_ipid;
+    uint32_t m_win;       // bound of on-the-fly packets
+    uint64_t m_baseRtt;   // base RTT of this qp
+    DataRate m_max_rate;  // max rate
+    bool m_var_win;       // variable window size
+    Time m_nextAvail;     //< Soonest time of next send
+    uint32_t wp;          // current window of packets
+    uint32_t lastPktSize;
+    int32_t m_flow_id;
+    Time m_timeout;
+    uint32_t m_grpIdx;  // index in the RdmaQueuePairGroup it was last added to
+
+    /******************************
+     * Per-QP DCQCN CC parameters
+     * (populated from RdmaHw defaults or per-PG overrides)
+     *****************************/
+    DcqcnParams m_dcqcnParams;
+
+    /******************************
+     * runtime states
+     *****************************/
+    DataRate m_rate;  //< Current rate
+    struct {
+        DataRate m_targetRate;  //< Target rate
+        EventId m_eventUpdateAlpha;
+        double m_alpha;
+        bool m_alpha_cnp_arrived;  // indicate if CNP arrived in the last slot
+        bool m_first_cnp;          // indicate if the current CNP is the first CNP
+        EventId m_eventDecreaseRate;
+        bool m_decrease_cnp_arrived;  // indicate if CNP arrived in the last slot
+        uint32_t m_rpTimeStage;
+        EventId m_rpTimer;
+    } mlx;
+    struct {
+        uint32_t m_lastUpdateSeq;
+        DataRate m_curRate;
+        IntHop hop[IntHeader::maxHop];
+        uint32_t keep[IntHeader::maxHop];
+        uint32_t m_incStage;
+        double m_lastGap;
+        double u;
+        struct {
+            double u;
+            DataRate Rc;
+            uint32_t incStage;
+        } hopState[IntHeader::maxHop];
+    } hp;
+    struct {
+        uint32_t m_lastUpdateSeq;
+        DataRate m_curRate;
+        uint32_t m_incStage;
+        uint64_t lastRtt;
+        double rttDiff;
+    } tmly;
+    struct {
+        uint32_t m_lastUpdateSeq;
+        uint32_t m_caState;
+        uint32_t m_highSeq;  // when to exit cwr
+        double m_alpha;
+        uint32_t m_ecnCnt;
+        uint32_t m_batchSizeOfAlpha;
+    } dctcp;
+
+    struct {
+        bool m_enabled;
+        uint32_t m_bdp;          // m_irn_maxAck_
+        uint32_t m_highest_ack;  // m_irn_maxAck_
+        uint32_t m_max_seq;      // m_irn_maxSeq_
+        Time m_rtoLow;
+        Time m_rtoHigh;
+        IrnSackManager m_sack;
+        bool m_recovery;
+        uint32_t m_recovery_seq;
+    } irn;
+
+    struct {
+        uint64_t txTotalPkts{0};
+        uint64_t txTotalBytes{0};
+    } stat;
+
+    // headers of the data packets, initialized by the first GetNxtPacket
+    RdmaDataHeader m_dataHeader;
+
+    // Implement Timeout according to IB Spec Vol. 1 C9-139.
+    // For an HCA requester using Reliable Connection service, to detect missing responses,
+    // every Send queue is required to implement a Transport Timer to time outstanding requests.
+    EventId m_retransmit;
+
+    /***********
+     * methods
+     **********/
+    static TypeId GetTypeId(void);
+    RdmaQueuePair(uint16_t pg, Ipv4Address _sip, Ipv4Address _dip, uint16_t _sport,
+                  uint16_t _dport);
+    void SetSize(uint64_t size);
+    void SetWin(uint32_t win);
+    void SetBaseRtt(uint64_t baseRtt);
+    void SetVarWin(bool v);
+    void SetFlowId(int32_t v);
+    void SetTimeout(Time v);
+
+    uint64_t GetBytesLeft();
+    uint32_t GetHash(void);
+    void Acknowledge(uint64_t ack);
+    uint64_t GetOnTheFly();
+    bool IsWinBound();
+    uint64_t GetWin();  // window size calculated from m_rate
+    bool IsFinished();
+    inline bool IsFinishedConst() const { return snd_una >= m_size; }
+
+    uint64_t HpGetCurWin();  // window size calculated from hp.m_curRate, used by HPCC
+
+    inline uint32_t GetIrnBytesInFlight() const {
+        // IRN do not consider SACKed segments for simplicity
+        return irn.m_max_seq - irn.m_highest_ack;
+    }
+
+    Time GetRto(uint32_t mtu) {
+        if (irn.m_enabled) {
+            if (GetIrnBytesInFlight() > 3 * mtu) {
+                return irn.m_rtoHigh;
+            }
+            return irn.m_rtoLow;
+        } else {
+            return m_timeout;
+        }
+    }
+
+    inline bool CanIrnTransmit(uint32_t mtu) const {
+        uint64_t len_left = m_size >= snd_nxt ? m_size - snd_nxt : 0;
+
+        return !irn.m_enabled ||
+               (GetIrnBytesInFlight() + ((len_left > mtu) ? mtu : len_left)) < irn.m_bdp ||
+               (irn.m_highest_ack + irn.m_bdp > snd_nxt);
+    }
+};
+
+class RdmaRxQueuePair : public Object {  // Rx side queue pair
+   public:
+    struct ECNAccount {
+        uint16_t qIndex;
+        uint8_t ecnbits;
+        uint16_t qfb;
+        uint16_t total;
+
+        ECNAccount() { memset(this, 0, sizeof(ECNAccount)); }
+    };
+    ECNAccount m_ecn_source;
+    uint32_t sip, dip;
+    uint16_t sport, dport;
+    uint16_t m_ipid;
+    uint32_t ReceiverNextExpectedSeq;
+    Time m_nackTimer;
+    int32_t m_milestone_rx;
+    uint32_t m_lastNACK;
+    EventId QcnTimerEvent;  // if destroy this rxQp, remember to cancel this timer
+    IrnSackManager m_irn_sack_;
+    int32_t m_flow_id;
+
+    static TypeId GetTypeId(void);
+    RdmaRxQueuePair();
+    uint32_t GetHash(void);
+};
+
+/**
+ * The tx QPs of a NIC, indexed in the order they were added.
+ *
+ * Finished QPs stay in place (marked by SetQpFinished) until Compact ()
+ * removes them; it keeps the order of the others, so the round robin of
+ * RdmaEgressQueue over them is not changed, and the group stays as large
+ * as the number of active QPs rather than of all QPs ever created.
+ */
+class RdmaQueuePairGroup : public Object {
+   public:
+    std::vector<Ptr<RdmaQueuePair>> m_qps;
+    // std::vector<Ptr<RdmaRxQueuePair> > m_rxQps;
+    std::vector<uint8_t> m_qp_finished;
+    uint32_t m_nFinished;
+    uint32_t m_generation;  // incremented whenever the indices of m_qps change
+
+    static TypeId GetTypeId(void);
+    RdmaQueuePairGroup(void);
+    uint32_t GetN(void);
+    Ptr<RdmaQueuePair> Get(uint32_t idx);
+    Ptr<RdmaQueuePair> operator[](uint32_t idx);
+    void AddQp(Ptr<RdmaQueuePair> qp);
+    // void AddRxQp(Ptr<RdmaRxQueuePair> rxQp);
+    void Clear(void);
+    /**
+     * Remove the finished QPs, keeping the order of the others.
+     * \returns the number of remaining QPs whose index was below pos
+     */
+    uint32_t Compact(uint32_t pos);
+    uint32_t GetNFinished(void) const { return m_nFinished; }
+    inline bool IsQpFinished(uint32_t idx) const { return m_qp_finished[idx]; }
+
+    inline void SetQpFinished(uint32_t idx) {
+        if (m_qp_finished[idx]) return;
+        m_qp_finished[idx] = 1;
+        m_nFinished++;
+    }
+};
+
+}  // namespace ns3
+
+#endif /* RDMA_QUEUE_PAIR_H */
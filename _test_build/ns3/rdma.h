@@ -0,0 +1,6 @@
+#ifndef RDMA_H
+#define RDMA_H
+
+#define ENABLE_QP 1
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef SWITCH_NODE_H
+#define SWITCH_NODE_H
+
+#include <ns3/node.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sstream>
+
+#include "qbb-net-device.h"
+#include "switch-mmu.h"
+#include "ns3/credit-feedback-header.h"
+#include "ns3/drill-engine.h"
+#include "ns3/ecmp-fib.h"
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+class Packet;
+
+class PathTag : public Tag {
+   public:
+    static TypeId GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::PathTag").SetParent<Tag>().AddConstructor<PathTag>();
+        return tid;
+    }
+    virtual TypeId GetInstanceTypeId(void) const { return GetTypeId(); }
+    virtual uint32_t GetSerializedSize(void) const { return sizeof(m_size) + m_size * sizeof(uint32_t); }
+    virtual void Serialize(TagBuffer buf) const {
+        buf.WriteU32(m_size);
+        for (uint32_t i = 0; i < m_size; i++) {
+            buf.WriteU32(m_nodes[i]);
+        }
+    }
+    virtual void Deserialize(TagBuffer buf) {
+        m_size = buf.ReadU32();
+        for (uint32_t i = 0; i < m_size; i++) {
+            m_nodes[i] = buf.ReadU32();
+        }
+    }
+    virtual void Print(std::ostream &os) const {
+        os << "PathSize=" << m_size << " Path=";
+        for (uint32_t i = 0; i < m_size; i++) {
+            os << m_nodes[i] << (i == m_size - 1 ? "" : "->");
+        }
+    }
+
+    PathTag() : m_size(0) {}
+    void AddNode(uint32_t nodeId) {
+        if (m_size < 16) {
+            m_nodes[m_size++] = nodeId;
+        }
+    }
+    std::vector<uint32_t> GetPath() const {
+        return std::vector<uint32_t>(m_nodes, m_nodes + m_size);
+    }
+    std::string GetPathString() const {
+        std::stringstream ss;
+        for (uint32_t i = 0; i < m_size; i++) {
+            ss << m_nodes[i] << (i == m_size - 1 ? "" : "-");
+        }
+        return ss.str();
+    }
+
+   private:
+    uint32_t m_nodes[16];
+    uint32_t m_size;
+};
+
+class SwitchNode : public Node {
+    static const unsigned qCnt = 8;    // Number of queues/priorities used
+    static const unsigned pCnt = 128;  // port 0 is not used so + 1	// Number of ports used
+    uint32_t m_ecmpSeed;
+    EcmpFib m_rtTable;  // map from ip address (u32) to possible ECMP port (index of dev)
+
+    // monitor uplinks
+    uint64_t m_txBytes[pCnt];  // counter of tx bytes, for HPCC
+    uint64_t m_rxBytes[pCnt];  // counter of rx bytes, for throughput monitoring
+    
+    // For throughput/utilization calculation (cumulative counters at sample points)
+    uint64_t m_txBytesSample[pCnt];  // tx bytes at last sample point
+    uint64_t m_rxBytesSample[pCnt];  // rx bytes at last sample point
+
+   protected:
+    bool m_ecnEnabled;
+    uint32_t m_ccMode;
+    uint32_t m_ackHighPrio;  // set high priority for ACK/NACK
+
+   private:
+    int GetOutDev(Ptr<Packet>, CustomHeader &ch);
+    void SendToDev(Ptr<Packet> p, CustomHeader &ch);
+    void SendToDevContinue(Ptr<Packet> p, CustomHeader &ch);
+    static uint32_t EcmpHash(const uint8_t *key, size_t len, uint32_t seed);
+    void CheckAndSendPfc(uint32_t inDev, uint32_t qIndex);
+    void CheckAndSendResume(uint32_t inDev, uint32_t qIndex);
+
+    /* Sending packet to Egress port */
+    void DoSwitchSend(Ptr<Packet> p, CustomHeader &ch, uint32_t outDev, uint32_t qIndex);
+    /* ConWeave: charge a packet held in a VOQ to its ingress (enqueue), or release it;
+     * false: the ingress admission refused (and dropped) the packet */
+    bool ChargeVOQBuffer(Ptr<Packet> p, CustomHeader &ch, bool enqueue);
+
+    /*----- CPEM: Credit-based PFC Enhancement Module -----*/
+    void CpemSendFeedback(uint32_t inPort, uint32_t outPort);
+    void CpemHandleFeedback(Ptr<Packet> p, CustomHeader &ch);
+    void CpemStartFeedbackGeneration();
+    void CpemPeriodicFeedbackCheck(uint32_t port);
+
+    /*----- Background Flow with Fixed Path -----*/
+    bool IsBackgroundFlow(const CustomHeader &ch);
+    uint32_t GetBackgroundFlowPath(const CustomHeader &ch);
+
+    /*----- Load balancer -----*/
+    // Flow ECMP (lb_mode = 0)
+    uint32_t DoLbFlowECMP(Ptr<const Packet> p, const CustomHeader &ch,
+                          const EcmpGroup &nexthops);
+    // DRILL (lb_mode = 2)
+    uint32_t DoLbDrill(Ptr<const Packet> p, const CustomHeader &ch,
+                       const EcmpGroup &nexthops);        // choose egress port
+    uint32_t m_drill_candidate;                           // d: ports sampled per packet
+    uint32_t m_drill_memory;                              // m: best ports kept per ECMP group
+    DrillEngine m_drill;                                  // samples from this switch's stream
+    std::vector<QbbNetDevice *> m_qbbDevices;             // m_devices, cast once
+    uint32_t CalculateInterfaceLoad(uint32_t interface);  // Get the load of a interface
+    // Conga (lb_mode = 3)
+    uint32_t DoLbConga(Ptr<Packet> p, CustomHeader &ch, const EcmpGroup &nexthops);
+    // Conga (lb_mode = 6)
+    uint32_t DoLbLetflow(Ptr<Packet> p, CustomHeader &ch, const std::vector<int> &nexthops);
+    // ConWeave (lb_mode = 9)
+    uint32_t DoLbConWeave(Ptr<const Packet> p, const CustomHeader &ch,
+                           const EcmpGroup &nexthops);  // dummy
+
+   public:
+    // Ptr<BroadcomNode> m_broadcom;
+    Ptr<SwitchMmu> m_mmu;
+    bool m_isToR;                                 // true if ToR switch
+    std::unordered_set<uint32_t> m_isToR_hostIP;  // host's IP connected to this ToR
+
+    static TypeId GetTypeId(void);
+    SwitchNode();
+    void SetEcmpSeed(uint32_t seed);
+    void AddTableEntry(Ipv4Address &dstAddr, uint32_t intf_idx);
+    void SetTableEntry(Ipv4Address &dstAddr, const std::vector<int> &intf_idx);
+    void ClearTable();
+    bool SwitchReceiveFromDevice(Ptr<NetDevice> device, Ptr<Packet> packet, CustomHeader &ch);
+    void SwitchNotifyDequeue(uint32_t ifIndex, uint32_t qIndex, Ptr<Packet> p);
+    uint64_t GetTxBytesOutDev(uint32_t outdev);
+    uint64_t GetRxBytesInDev(uint32_t indev);
+    
+    // Throughput and utilization monitoring
+    void ResetThroughputCounters();  // Reset sample counters for new interval
+    uint64_t GetTxBytesDelta(uint32_t outdev);  // Get TX bytes since last sample
+    uint64_t GetRxBytesDelta(uint32_t indev);   // Get RX bytes since last sample
+    void UpdateSampleCounters();  // Update sample point counters
+    
+    // CPEM public interface
+    void CpemInit();
+};
+
+} /* namespace ns3 */
+
+#endif /* SWITCH_NODE_H */
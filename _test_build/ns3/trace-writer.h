@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * @brief Writer of a table of monitoring records (FCT, PFC, qlen, ...)
+ *
+ * The columns are declared once, then every row is written with Put()
+ * for each column and EndRow().  In TEXT format a row is one line, with
+ * the columns separated by a given character and unsigned integers
+ * printed like "%lu" and doubles like "%.<precision>f", i.e. the format
+ * the monitors always wrote.
+ *
+ * In BINARY format the file is (all fields in host byte order):
+ * - a header: magic "NS3TRC1\0", uint32 0x01020304 (byte order mark),
+ *   uint32 version, uint32 #columns, uint32 rows per block, uint32 name
+ *   length and the table name, then per column uint8 type (ColumnType),
+ *   uint8 precision, uint16 name length and the column name;
+ * - blocks of up to kRowsPerBlock rows, stored column by column: uint32
+ *   block magic, uint32 #rows, then per column uint8 width, 7 bytes of
+ *   padding, uint64 base and #rows values of width bytes.  An unsigned
+ *   value is base + the stored value (width 0, 1, 2, 4 or 8 bytes, the
+ *   narrowest which fits the block); a double is stored as its 8 raw
+ *   bytes, with base 0;
+ * - at Close(), an index of fixed-size entries, one per block: uint64
+ *   file offset, uint64 #rows, uint64 min and max of the first column
+ *   (the timestamp of every monitor table) in the block, followed by a
+ *   trailer: uint64 index offset, uint64 #blocks, uint64 #rows and the
+ *   magic "NS3TIDX\0".
+ * A column chunk maps directly to a numpy array, and the index can be
+ * mmapped to seek to a time range.  A file without trailer (the run was
+ * killed) can still be read block by block.  analysis/trace_reader.py
+ * reads both formats.
+ */
+class TraceWriter {
+   public:
+    enum Format { TEXT = 0, BINARY = 1 };
+    enum ColumnType { UINT = 0, DOUBLE = 1 };
+    static const uint32_t kRowsPerBlock = 4096;
+
+    /**
+     * @param file output file, owned (closed) by the writer
+     * @param name table name, stored in the binary header
+     * @param separator column separator of the TEXT format
+     */
+    TraceWriter(FILE *file, Format format, const std::string &name, char separator);
+    ~TraceWriter();
+    // owns the file and its pending block: not copyable
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    /**
+     * @brief Declare the next column.  All columns must be declared before
+     * the first row.
+     * @param precision digits after the decimal point of a DOUBLE in TEXT
+     */
+    void AddColumn(const std::string &name, ColumnType type, uint8_t precision = 0);
+    /**
+     * @brief TEXT only: write a "# comment" line, e.g. a format description
+     */
+    void Comment(const std::string &text);
+
+    void Put(uint64_t value);
+    void Put(double value);
+    /** @brief Value of a UINT column from any non-negative integer */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type Put(T value) {
+        NS_ASSERT_MSG(!std::is_signed<T>::value || value >= 0,
+                      "TraceWriter: negative value in a UINT column of " << m_name);
+        Put(static_cast<uint64_t>(value));
+    }
+    void EndRow();
+
+    /**
+     * @brief Make the rows written so far visible in TEXT format.  Rows of
+     * the BINARY format leave by whole blocks, so this does nothing there.
+     */
+    void Flush();
+    /**
+     * @brief Write the rows left and the index, and close the file
+     */
+    void Close();
+
+    Format GetFormat() const { return m_format; }
+
+    /**
+     * @brief Path of the BINARY version of a text trace: ".txt" replaced by
+     * ".bin" (or ".bin" appended)
+     */
+    static std::string BinaryPath(const std::string &textPath);
+
+   private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        uint8_t precision;
+        std::vector<uint64_t> values;  // current block (doubles as raw bits)
+    };
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t rows;
+        uint64_t minKey;
+        uint64_t maxKey;
+    };
+
+    void WriteHeader();
+    void WriteBlock();
+    void Write(const void *data, size_t size);
+
+    FILE *m_file;
+    Format m_format;
+    std::string m_name;
+    char m_separator;
+    std::vector<Column> m_columns;
+    uint32_t m_col;     // next column of the current row
+    bool m_started;     // first row begun: columns are fixed
+    std::string m_line; // current TEXT row
+    uint32_t m_blockRows;
+    uint64_t m_offset;  // bytes written
+    uint64_t m_rows;
+    std::vector<IndexEntry> m_index;
+};
+
+}  // namespace ns3
+
+#endif /* TRACE_WRITER_H */
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <stdint.h>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ns3/flow-trace.h"
+
+namespace ns3 {
+
+/**
+ * @brief Flow size distribution read from a CDF file of traffic_gen/
+ *
+ * One "size percentile" pair per line, the percentiles in [0, 100] or
+ * [0, 1], ascending and starting at 0.  Sizes are interpolated linearly
+ * between the points, as traffic_gen/custom_rand.py does.
+ */
+class FlowSizeCdf {
+   public:
+    /**
+     * @returns false, with `error` set, if the file cannot be read or is
+     * not a valid CDF
+     */
+    bool Load(const std::string &path, std::string &error);
+
+    double GetAvg() const;
+    /**
+     * @param u uniform in [0, 1)
+     */
+    double Sample(double u) const;
+
+   private:
+    std::vector<std::pair<double, double>> m_points;  // (size, percentile in [0, 100])
+};
+
+/**
+ * @brief Flows generated on demand, in start time order
+ *
+ * Replaces the flow files of traffic_gen.py and gen_alltoall.py: only the
+ * state of the next flows is kept, so memory does not depend on the length
+ * of the run.  Patterns:
+ * - POISSON: every host starts flows to uniformly random other hosts, with
+ *   exponential inter-arrival times so that it sends `load` of its
+ *   bandwidth on average, and sizes drawn from the CDF (traffic_gen.py);
+ * - INCAST: every `interval`, `fanIn` random hosts start a flow each to a
+ *   random other host at the same time;
+ * - ALLTOALL: every `interval`, every host starts a flow to every other
+ *   host, split into `chunks` flows `chunkGap` apart (gen_alltoall.py).
+ * Flow sizes of INCAST and ALLTOALL are `size`, or drawn from the CDF when
+ * it is 0; an ALLTOALL `size` is split over the chunks, the last one taking
+ * the remainder.
+ */
+class WorkloadGenerator {
+   public:
+    enum Pattern { POISSON = 0, INCAST = 1, ALLTOALL = 2 };
+
+    struct Config {
+        Pattern pattern = POISSON;
+        std::vector<uint32_t> hosts;  // node ids
+        uint64_t startNs = 0;
+        uint64_t stopNs = 0;  // no flow starts after
+        uint32_t seed = 1;
+        uint32_t pg = 3;
+        // POISSON
+        double load = 0;     // fraction of the host bandwidth
+        double hostBw = 0;   // bps
+        // INCAST, ALLTOALL
+        uint64_t size = 0;   // bytes, 0: from the CDF
+        uint64_t interval = 0;  // ns between two rounds
+        uint32_t fanIn = 0;
+        uint32_t chunks = 1;
+        uint64_t chunkGap = 0;  // ns
+    };
+
+    /**
+     * @param cdf flow sizes, may be null for INCAST and ALLTOALL with a size
+     */
+    WorkloadGenerator(const Config &config, const FlowSizeCdf *cdf);
+
+    /**
+     * @returns an empty string, or why the configuration cannot be generated
+     */
+    std::string Check() const;
+
+    /**
+     * @brief The next flow, in start time order
+     * @returns false when no more flow starts before stopNs
+     */
+    bool Next(FlowTraceRecord &flow);
+
+   private:
+    uint64_t DrawSize();
+    uint32_t DrawOtherHost(uint32_t self);  // index in m_config.hosts
+    uint64_t DrawInterArrival();
+    void StartRound();
+    void Emit(FlowTraceRecord &flow, uint64_t t, uint32_t src, uint32_t dst, uint64_t size);
+
+    Config m_config;
+    const FlowSizeCdf *m_cdf;
+    std::mt19937_64 m_rng;
+    std::uniform_real_distribution<double> m_uniform;
+    bool m_valid;  // Check() passed
+
+    // POISSON: next arrival (ns) of every host (index), earliest first
+    typedef std::pair<uint64_t, uint32_t> Arrival;
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> m_arrivals;
+    double m_meanInterArrival;  // ns
+
+    // INCAST, ALLTOALL: the current round, generated in order
+    uint64_t m_roundStart;
+    uint32_t m_incastDst;
+    std::vector<uint32_t> m_incastSrcs;
+    uint64_t m_cursor;  // next flow of the round
+};
+
+}  // namespace ns3
+
+#endif /* WORKLOAD_GENERATOR_H */
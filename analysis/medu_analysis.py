@@ -20,6 +20,8 @@ from typing import Dict, List, Optional, Tuple
 import matplotlib.pyplot as plt
 import numpy as np
 
+from trace_reader import find_trace, open_trace
+
 
 ALG_NAME_MAP = {
     "conga": "CONGA",
@@ -122,7 +124,7 @@ def parse_summary(summary_path: Path) -> Dict[str, Dict[str, float]]:
 def parse_all_slowdown_from_fct(fct_path: Path) -> Dict[str, float]:
     """Compute all-flow slowdown stats from *_out_fct.txt as fallback."""
     slowdown_values: List[float] = []
-    with fct_path.open() as handle:
+    with open_trace(fct_path) as handle:
         for raw in handle:
             parts = raw.strip().split()
             if len(parts) < 8:
@@ -265,7 +267,7 @@ def collect_runs(base_dir: Path, pattern: str) -> List[Dict[str, object]]:
                 try:
                     if all_slowdown_cdf_path.exists():
                         summary["ALL"] = parse_all_slowdown_from_cdf(all_slowdown_cdf_path)
-                    elif fct_path.exists():
+                    elif Path(find_trace(fct_path)).exists():
                         summary["ALL"] = parse_all_slowdown_from_fct(fct_path)
                 except Exception as exc:
                     print(f"Warning: failed to compute ALL-flow metrics for {run_name}: {exc}")
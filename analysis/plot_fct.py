@@ -9,6 +9,7 @@ import matplotlib.pyplot as plt
 import matplotlib.ticker as tick
 import math
 from cycler import cycler
+from trace_reader import find_trace, open_trace
 
 
 
@@ -120,7 +121,7 @@ def resolve_fct_path(output_dir, config_id):
     ]
 
     for candidate in candidates:
-        if os.path.isfile(candidate):
+        if os.path.isfile(find_trace(candidate)):
             return candidate
 
     # Default to current layout candidate so warning messages are meaningful.
@@ -133,10 +134,10 @@ def resolve_fct_path_from_run_dir(run_dir):
         os.path.join(run_dir, "{}_out_fct.txt".format(run_name)),
     ]
     for candidate in candidates:
-        if os.path.isfile(candidate):
+        if os.path.isfile(find_trace(candidate)):
             return candidate
 
-    matched = [f for f in os.listdir(run_dir) if f.endswith("_out_fct.txt")]
+    matched = [f for f in os.listdir(run_dir) if f.endswith("_out_fct.txt") or f.endswith("_out_fct.bin")]
     if len(matched) > 0:
         return os.path.join(run_dir, matched[0])
 
@@ -162,12 +163,12 @@ def size2str(steps):
 def get_steps_from_raw(filename, time_start, time_end, step=5):
     # time_start = int(2.005 * 1000000000)
     # time_end = int(3.0 * 1000000000)
-    if not os.path.isfile(filename):
+    if not os.path.isfile(find_trace(filename)):
         print("[WARN] FCT file not found, skip: {}".format(filename))
         return None
 
     fct_size = []
-    with open(filename, "r") as f:
+    with open_trace(filename) as f:
         for line in f:
             fields = line.strip().split()
             if len(fields) < 8:
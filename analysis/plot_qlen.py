@@ -7,6 +7,8 @@ import matplotlib
 matplotlib.use("Agg")
 import matplotlib.pyplot as plt
 
+from trace_reader import open_trace
+
 BASE_DIR = Path(__file__).resolve().parent
 REPO_ROOT = BASE_DIR.parent
 DEFAULT_INPUT_PATH = REPO_ROOT / "mix" / "output"
@@ -180,7 +182,7 @@ def parse_qlen(file_path: Path) -> Tuple[Optional[str], Dict[Tuple[int, int], Di
     if not file_path.exists():
         return fmt, data
 
-    with file_path.open("r", encoding="utf-8") as f:
+    with open_trace(file_path) as f:
         for raw_line in f:
             line = raw_line.strip()
             if not line or line.startswith("#"):
@@ -254,12 +256,16 @@ def parse_include_label(lbl: str) -> Optional[Tuple[int, int]]:
 
 def collect_qlen_files(input_path: Path, pattern: str) -> List[Path]:
     if input_path.is_file():
-        return [input_path] if input_path.name.endswith("qlen.txt") else []
+        return [input_path] if input_path.name.endswith(("qlen.txt", "qlen.bin")) else []
 
     if not input_path.exists() or not input_path.is_dir():
         return []
 
-    return sorted([p for p in input_path.rglob(pattern) if p.is_file()])
+    # binary traces (TRACE_FORMAT binary) are written as X.bin instead of X.txt
+    patterns = [pattern]
+    if pattern.endswith(".txt"):
+        patterns.append(pattern[:-len(".txt")] + ".bin")
+    return sorted([p for pat in patterns for p in input_path.rglob(pat) if p.is_file()])
 
 
 def resolve_output_dir(qlen_file: Path, output_root: Path, base_output_dir: Path) -> Path:
@@ -483,7 +489,7 @@ def plot_one_file(
         return out_png
 
 def main():
-    parser = argparse.ArgumentParser(description="Plot switch port queue length over time from qlen.txt files.")
+    parser = argparse.ArgumentParser(description="Plot switch port queue length over time from qlen.txt (or qlen.bin) files.")
     parser.add_argument(
         "-i", "--input",
         type=Path,
@@ -512,7 +518,7 @@ def main():
         "--pattern",
         type=str,
         default="*qlen.txt",
-        help="Glob pattern used when input is a directory (default: *qlen.txt).",
+        help="Glob pattern used when input is a directory (default: *qlen.txt; the .bin of a .txt pattern is matched too).",
     )
     parser.add_argument(
         "--max-ports",
@@ -12,6 +12,8 @@ from typing import Dict, Iterable, List, Optional, Tuple
 import matplotlib.pyplot as plt
 import numpy as np
 
+from trace_reader import open_trace
+
 
 ALG_ORDER = ["fecmp", "letflow", "conga", "conweave"]
 ALG_LABEL = {
@@ -138,7 +140,7 @@ def compute_run_metrics(
     short_fct_ns = 0
     long_fct_ns = 0
 
-    with fct_path.open() as handle:
+    with open_trace(fct_path) as handle:
         for raw_line in handle:
             parts = raw_line.split()
             if len(parts) < 8:
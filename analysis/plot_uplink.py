@@ -10,6 +10,7 @@ import matplotlib.ticker as tick
 import math
 from cycler import cycler
 import numpy as np
+from trace_reader import open_trace
 
 
 
@@ -215,7 +216,7 @@ def main():
                     filename_uplink = output_dir + "/{id}/{id}_out_uplink.txt".format(id=config_id)
                     port_list = set()
 
-                    with open(filename_uplink, "r") as f:
+                    with open_trace(filename_uplink) as f:
                         # parsing the results: (switch) -> timestamp
                         
                         history_data = {}
@@ -0,0 +1,197 @@
+"""Reader of the monitor traces written by the simulator (TRACE_FORMAT).
+
+Text traces are returned as they are parsed; binary traces (TRACE_FORMAT binary,
+see src/point-to-point/model/trace-writer.h for the layout) are decoded column by
+column with numpy, without parsing any text.
+
+    from trace_reader import read_trace
+    cols = read_trace("mix/output/1/1_out_qlen.bin")     # {name: numpy array}
+    cols = read_trace(path, time_range=(2.0e9, 2.1e9))   # only the blocks in range
+
+The analysis scripts read either format through open_trace, which yields the
+lines of the text format; give it the .txt path and it falls back to the .bin the
+simulator writes in its place:
+
+    with open_trace("mix/output/1/1_out_fct.txt") as f:
+        for line in f: ...
+
+Run as a script to print a binary trace in the text format of the simulator:
+
+    python3 analysis/trace_reader.py mix/output/1/1_out_fct.bin > fct.txt
+"""
+import argparse
+import io
+import mmap
+import os
+import struct
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+import numpy as np
+
+FILE_MAGIC = b"NS3TRC1\0"
+INDEX_MAGIC = b"NS3TIDX\0"
+BLOCK_MAGIC = 0x4B4C4254
+BYTE_ORDER_MARK = 0x01020304
+UINT, DOUBLE = 0, 1
+WIDTH_DTYPES = {1: np.uint8, 2: np.uint16, 4: np.uint32, 8: np.uint64}
+
+
+class Column:
+    def __init__(self, name: str, kind: int, precision: int):
+        self.name = name
+        self.kind = kind
+        self.precision = precision
+
+
+class BinaryTrace:
+    """A binary trace file, mmapped."""
+
+    def __init__(self, path):
+        self.path = Path(path)
+        with self.path.open("rb") as f:
+            self.buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        if self.buf[:8] != FILE_MAGIC:
+            raise ValueError("%s: not a binary trace" % path)
+        bom, = struct.unpack_from("<I", self.buf, 8)
+        self.order = "<" if bom == BYTE_ORDER_MARK else ">"
+        _, version, n_cols, self.rows_per_block, name_len = struct.unpack_from(
+            self.order + "5I", self.buf, 8)
+        pos = 28
+        self.name = self.buf[pos:pos + name_len].decode()
+        pos += name_len
+        self.columns: List[Column] = []
+        for _ in range(n_cols):
+            kind, precision, clen = struct.unpack_from(self.order + "BBH", self.buf, pos)
+            pos += 4
+            self.columns.append(Column(self.buf[pos:pos + clen].decode(), kind, precision))
+            pos += clen
+        self.data_start = pos
+        self.index = self._read_index()
+
+    def _read_index(self) -> List[Tuple[int, int, int, int]]:
+        """[(offset, rows, min key, max key)] from the index, or by walking the
+        blocks when the run did not close the file."""
+        size = len(self.buf)
+        if size >= self.data_start + 32 and self.buf[size - 8:] == INDEX_MAGIC:
+            index_offset, n_blocks, _ = struct.unpack_from(self.order + "3Q", self.buf, size - 32)
+            entries = np.frombuffer(self.buf, dtype=np.dtype(self.order + "u8"),
+                                    count=4 * n_blocks, offset=index_offset)
+            return [tuple(int(v) for v in entries[4 * i:4 * i + 4]) for i in range(n_blocks)]
+        index = []
+        pos = self.data_start
+        while pos + 8 <= size:
+            magic, rows = struct.unpack_from(self.order + "II", self.buf, pos)
+            if magic != BLOCK_MAGIC:
+                break
+            end = pos + 8
+            for _ in self.columns:
+                if end + 16 > size:
+                    return index
+                width = self.buf[end]
+                end += 16 + rows * width
+            if end > size:
+                break
+            index.append((pos, rows, 0, 2 ** 64 - 1))
+            pos = end
+        return index
+
+    def _decode_block(self, offset: int, rows: int) -> List[np.ndarray]:
+        pos = offset + 8
+        out = []
+        for col in self.columns:
+            width = self.buf[pos]
+            base, = struct.unpack_from(self.order + "Q", self.buf, pos + 8)
+            pos += 16
+            if col.kind == DOUBLE:
+                out.append(np.frombuffer(self.buf, dtype=np.dtype(self.order + "f8"),
+                                         count=rows, offset=pos).copy())
+            elif width == 0:
+                out.append(np.full(rows, base, dtype=np.uint64))
+            else:
+                raw = np.frombuffer(self.buf, dtype=np.dtype(self.order + "u%d" % width),
+                                    count=rows, offset=pos)
+                out.append(raw.astype(np.uint64) + np.uint64(base))
+            pos += rows * width
+        return out
+
+    def read(self, time_range: Optional[Tuple[float, float]] = None) -> Dict[str, np.ndarray]:
+        """All rows, or the rows whose first column lies in [lo, hi]."""
+        chunks: List[List[np.ndarray]] = [[] for _ in self.columns]
+        for offset, rows, lo, hi in self.index:
+            if time_range is not None and (hi < time_range[0] or lo > time_range[1]):
+                continue
+            for i, values in enumerate(self._decode_block(offset, rows)):
+                chunks[i].append(values)
+        cols = {}
+        for col, parts in zip(self.columns, chunks):
+            dtype = np.float64 if col.kind == DOUBLE else np.uint64
+            cols[col.name] = np.concatenate(parts) if parts else np.empty(0, dtype=dtype)
+        if time_range is not None and self.columns and self.columns[0].kind == UINT:
+            key = cols[self.columns[0].name]
+            keep = (key >= time_range[0]) & (key <= time_range[1])
+            cols = {name: values[keep] for name, values in cols.items()}
+        return cols
+
+    def write_text(self, out, separator: str) -> None:
+        """Print the rows like the simulator does in TRACE_FORMAT text."""
+        for offset, rows, _, _ in self.index:
+            block = self._decode_block(offset, rows)
+            strs = []
+            for col, values in zip(self.columns, block):
+                if col.kind == DOUBLE:
+                    strs.append(["%.*f" % (col.precision, v) for v in values])
+                else:
+                    strs.append([str(v) for v in values.tolist()])
+            for row in zip(*strs):
+                out.write(separator.join(row) + "\n")
+
+
+# separator of each trace in the text format
+TEXT_SEPARATORS = {"fct": " ", "pfc": " ", "cnp": " "}
+
+
+def read_trace(path, time_range: Optional[Tuple[float, float]] = None) -> Dict[str, np.ndarray]:
+    """Columns of a binary trace (any other file is rejected)."""
+    return BinaryTrace(path).read(time_range)
+
+
+def find_trace(path) -> str:
+    """path, or the binary trace written in place of it (TRACE_FORMAT binary
+    turns X.txt into X.bin); path itself when neither exists."""
+    path = str(path)
+    if os.path.isfile(path):
+        return path
+    binary = (path[:-len(".txt")] if path.endswith(".txt") else path) + ".bin"
+    return binary if os.path.isfile(binary) else path
+
+
+def is_binary_trace(path) -> bool:
+    with open(path, "rb") as f:
+        return f.read(len(FILE_MAGIC)) == FILE_MAGIC
+
+
+def open_trace(path):
+    """The lines of a text or a binary trace (told apart by the magic, after
+    find_trace), as the simulator prints them in the text format."""
+    path = find_trace(path)
+    if not is_binary_trace(path):
+        return open(path, "r")
+    trace = BinaryTrace(path)
+    out = io.StringIO()
+    trace.write_text(out, TEXT_SEPARATORS.get(trace.name, ","))
+    out.seek(0)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Print a binary simulator trace as text")
+    parser.add_argument("trace", help="binary trace (.bin)")
+    args = parser.parse_args()
+    trace = BinaryTrace(args.trace)
+    trace.write_text(sys.stdout, TEXT_SEPARATORS.get(trace.name, ","))
+
+
+if __name__ == "__main__":
+    main()
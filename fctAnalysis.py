@@ -2,6 +2,12 @@ import subprocess
 import argparse
 import numpy as np
 import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "analysis"))
+from trace_reader import find_trace, is_binary_trace
+
+TRACE_READER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "analysis", "trace_reader.py")
 
 
 def get_flow_threshold_from_config(config_path, fallback_threshold=None):
@@ -122,12 +128,15 @@ if __name__=="__main__":
 	time_limit_start = args.time_limit_begin
 	time_limit_end = args.time_limit_end
 
-	# read lines
-	file = "%s"%(output_fct)
-	cmd_absolute = "cat %s"%(file) + " | awk '{if ($6>" + "%d"%time_limit_start + " && $6+$7<" + "%d"%(time_limit_end) + ") {print $7/1000, $5} }' | sort -n -k 2"
+	# read lines (a binary trace is printed as text by trace_reader.py)
+	file = find_trace(output_fct)
+	cat = "cat %s"%(file)
+	if os.path.isfile(file) and is_binary_trace(file):
+		cat = "%s %s %s"%(sys.executable, TRACE_READER, file)
+	cmd_absolute = cat + " | awk '{if ($6>" + "%d"%time_limit_start + " && $6+$7<" + "%d"%(time_limit_end) + ") {print $7/1000, $5} }' | sort -n -k 2"
 	print(cmd_absolute)
 	output_absolute = subprocess.check_output(cmd_absolute, shell=True)
-	cmd_slowdown = "cat %s"%(file) + " | awk '{if ($6>" + "%d"%time_limit_start + " && $6+$7<" + "%d"%(time_limit_end) + ") {print $7/$8<1?1:$7/$8, $5} }' | sort -n -k 2"
+	cmd_slowdown = cat + " | awk '{if ($6>" + "%d"%time_limit_start + " && $6+$7<" + "%d"%(time_limit_end) + ") {print $7/$8<1?1:$7/$8, $5} }' | sort -n -k 2"
 	print(cmd_slowdown)
 	output_slowdown = subprocess.check_output(cmd_slowdown, shell=True)
 